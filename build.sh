@@ -1,5 +1,13 @@
 #!/bin/bash
 
+# ./build.sh --unattended: ohne Rückfrage und ohne Monitor. Die Ergebnisse
+# landen im Ergebnislog (Partition "benchlog") und werden später über die
+# Konsole mit "log -d" ausgelesen.
+UNATTENDED=0
+if [ "$1" = "--unattended" ]; then
+    UNATTENDED=1
+fi
+
 echo "Starte ESP32 Build-Prozess in $(pwd)"
 
 # Prüfe ob IDF_PATH gesetzt ist
@@ -9,9 +17,11 @@ if [ -z "$IDF_PATH" ]; then
     exit 1
 fi
 
-echo "Bitte manuell: STRG-T + STRG-X drücken falls nötig"
-echo " Drücke ENTER um fortzufahren..."
-read
+if [ $UNATTENDED -eq 0 ]; then
+    echo "Bitte manuell: STRG-T + STRG-X drücken falls nötig"
+    echo " Drücke ENTER um fortzufahren..."
+    read
+fi
 
 echo "Clean..."
 idf.py fullclean || exit 1
@@ -22,5 +32,10 @@ idf.py build || exit 1
 echo "Flash..."
 idf.py flash || exit 1
 
+if [ $UNATTENDED -eq 1 ]; then
+    echo "Fertig. Ergebnisse später auslesen: Konsole \"log -d\" (scripts/serial_logger.py)"
+    exit 0
+fi
+
 echo "Monitor..."
 idf.py -p /dev/ttyUSB0 monitor
\ No newline at end of file
@@ -0,0 +1,413 @@
+// Anwendungskernel über Puffergrößen: Zyklen pro Byte
+//
+// Jede Variante aus app_kernels.c läuft über 16 Byte bis BENCH_APP_MAX_KB
+// (Faktor 4). Iterationen = Byte, die Registry meldet damit direkt Zyklen
+// pro Byte. SHA-256 und AES-128-CBC laufen zusätzlich über mbedtls - auf dem
+// ESP32-C6 mit CONFIG_MBEDTLS_HARDWARE_SHA/AES über die Beschleuniger. Die
+// mbedtls-Messung enthält den kompletten Aufruf (Kontext, Schlüssel,
+// Abschluss); die Softwarevarianten enthalten ebenso die Schlüsselexpansion.
+// Daraus ergibt sich der Crossover: ab welcher Größe sich mbedtls lohnt.
+
+#include "app_bench.h"
+#include "app_kernels.h"
+#include "bench_registry.h"
+#include "measurement_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/aes.h"
+
+// ============ KONFIGURATION ============
+#define APP_MIN_BYTES           16
+#define APP_MAX_BYTES           (CONFIG_BENCH_APP_MAX_KB * 1024)
+#define APP_BLOCK_BYTES         16      // AES-Block, alle Größen sind Vielfache
+#define APP_FIR_TAPS            16
+#define APP_SIZE_COUNT          7       // 16, 64, 256, 1K, 4K, 16K, 64K
+#define MAX_NAME_LEN            32
+
+#if CONFIG_MBEDTLS_HARDWARE_SHA
+#define APP_SHA_TAGS            "app,crypto,hw"
+#else
+#define APP_SHA_TAGS            "app,crypto"
+#endif
+#if CONFIG_MBEDTLS_HARDWARE_AES
+#define APP_AES_TAGS            "app,crypto,hw"
+#else
+#define APP_AES_TAGS            "app,crypto"
+#endif
+
+// Tiefpass, Summe der Beträge 32640 < 1.0 in Q15: kein Überlauf im Akkumulator
+static const int16_t k_fir_taps[APP_FIR_TAPS] = {
+    120, -340, -610, 0, 1450, 3300, 4900, 5600, 5600, 4900, 3300, 1450, 0, -610, -340, 120,
+};
+
+static const uint8_t k_aes_key[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c,
+};
+
+// ============ VARIANTEN ============
+enum app_kind {
+    APP_CRC32_NAIVE, APP_CRC32_TABLE, APP_CRC32_SLICE4,
+    APP_FLETCHER_NAIVE, APP_FLETCHER_BLOCKED, APP_FLETCHER_WORD,
+    APP_FIR_NAIVE, APP_FIR_UNROLL,
+    APP_DOT_NAIVE, APP_DOT_UNROLL,
+    APP_SHA256_NAIVE, APP_SHA256_UNROLL, APP_SHA256_MBEDTLS,
+    APP_AES_NAIVE, APP_AES_TTABLE, APP_AES_MBEDTLS,
+    APP_KIND_COUNT
+};
+
+typedef struct {
+    const char* kernel;
+    const char* variant;
+    const char* tags;
+    bool mbedtls;
+} app_kind_t;
+
+static const app_kind_t k_app_kinds[APP_KIND_COUNT] = {
+    { "crc32", "naive", "app,crc", false },
+    { "crc32", "table", "app,crc", false },
+    { "crc32", "slice4", "app,crc", false },
+    { "fletcher32", "naive", "app,checksum", false },
+    { "fletcher32", "blocked", "app,checksum", false },
+    { "fletcher32", "word", "app,checksum", false },
+    { "fir", "naive", "app,dsp", false },
+    { "fir", "unroll", "app,dsp", false },
+    { "dot", "naive", "app,dsp", false },
+    { "dot", "unroll", "app,dsp", false },
+    { "sha256", "naive", "app,crypto", false },
+    { "sha256", "unroll", "app,crypto", false },
+    { "sha256", "mbedtls", APP_SHA_TAGS, true },
+    { "aes128cbc", "naive", "app,crypto", false },
+    { "aes128cbc", "ttable", "app,crypto", false },
+    { "aes128cbc", "mbedtls", APP_AES_TAGS, true },
+};
+
+typedef struct {
+    uint8_t kind;
+    uint32_t bytes;
+    float best;                 // Minimum Zyklen pro Byte
+} app_case_t;
+
+#define MAX_APP_CASES           (APP_KIND_COUNT * APP_SIZE_COUNT)
+
+static app_case_t s_cases[MAX_APP_CASES];
+static bench_def_t s_defs[MAX_APP_CASES];
+static char s_names[MAX_APP_CASES][MAX_NAME_LEN];
+static uint32_t s_case_count;
+
+// Quelle mit Vorlauf für die FIR-Historie, Ziel für FIR/AES
+static uint8_t* s_app_src;
+static uint8_t* s_app_dst;
+
+// ============ MESSUNG ============
+/**
+ * @brief Legt Quell- und Zielpuffer beim ersten Sample an
+ * @return false, wenn der Heap nicht reicht
+ */
+static bool app_buffers(void) {
+    if (s_app_src != NULL) {
+        return true;
+    }
+    s_app_src = (uint8_t*)malloc(APP_MAX_BYTES + 2 * APP_FIR_TAPS);
+    s_app_dst = (uint8_t*)malloc(APP_MAX_BYTES);
+    if (s_app_src == NULL || s_app_dst == NULL) {
+        printf("Anwendungskernel: %" PRIu32 " Byte Puffer nicht verfügbar\n", (uint32_t)APP_MAX_BYTES);
+        free(s_app_src);
+        free(s_app_dst);
+        s_app_src = s_app_dst = NULL;
+        return false;
+    }
+    uint32_t state = 0x12345678u;
+    for (uint32_t i = 0; i < APP_MAX_BYTES + 2 * APP_FIR_TAPS; i++) {
+        state = state * 1664525u + 1013904223u;
+        s_app_src[i] = (uint8_t)(state >> 24);
+    }
+    return true;
+}
+
+/**
+ * @brief AES-128-CBC über mbedtls: Kontext, Schlüssel, Verschlüsselung
+ * @return 0 oder Fehlercode von mbedtls
+ */
+static int aes128_cbc_mbedtls(uint8_t* iv, const uint8_t* in, uint8_t* out, uint32_t bytes) {
+    mbedtls_aes_context aes;
+    mbedtls_aes_init(&aes);
+    int ret = mbedtls_aes_setkey_enc(&aes, k_aes_key, 128);
+    if (ret == 0) {
+        ret = mbedtls_aes_crypt_cbc(&aes, MBEDTLS_AES_ENCRYPT, bytes, iv, in, out);
+    }
+    mbedtls_aes_free(&aes);
+    return ret;
+}
+
+/**
+ * @brief Verarbeitet iterations Byte mit einer Kernel-Variante
+ * FIR: Byte = Eingangssamples (Historie davor liegt außerhalb),
+ * dot: beide Vektoren zusammen, AES/mbedtls: inklusive Schlüsselaufbau.
+ * Meldet mbedtls einen Fehler, zählt das Sample nicht (0 Zyklen, kein Bestwert).
+ */
+static uint32_t bench_app(void* arg, uint32_t iterations, uint32_t* result) {
+    app_case_t* c = (app_case_t*)arg;
+    uint32_t bytes = iterations < APP_MAX_BYTES ? iterations : APP_MAX_BYTES;
+    bytes = bytes >= APP_BLOCK_BYTES ? bytes - bytes % APP_BLOCK_BYTES : APP_BLOCK_BYTES;
+
+    if (!app_buffers()) {
+        *result = 0;
+        return 0;
+    }
+
+    const uint8_t* src = s_app_src;
+    const int16_t* samples = (const int16_t*)s_app_src;
+    uint8_t* dst = s_app_dst;
+    uint32_t out = 0;
+    uint8_t digest[32];
+    uint8_t iv[16];
+    aes128_key_t key;
+    int ret = 0;
+
+    uint32_t start = get_cycle_count();
+    switch (c->kind) {
+    case APP_CRC32_NAIVE:      out = crc32_naive(src, bytes); break;
+    case APP_CRC32_TABLE:      out = crc32_table(src, bytes); break;
+    case APP_CRC32_SLICE4:     out = crc32_slice4(src, bytes); break;
+    case APP_FLETCHER_NAIVE:   out = fletcher32_naive(src, bytes); break;
+    case APP_FLETCHER_BLOCKED: out = fletcher32_blocked(src, bytes); break;
+    case APP_FLETCHER_WORD:    out = fletcher32_word(src, bytes); break;
+    case APP_FIR_NAIVE:
+        fir_q15_naive(samples, bytes / 2 + APP_FIR_TAPS - 1, k_fir_taps, APP_FIR_TAPS, (int16_t*)dst);
+        break;
+    case APP_FIR_UNROLL:
+        fir_q15_unrolled(samples, bytes / 2 + APP_FIR_TAPS - 1, k_fir_taps, APP_FIR_TAPS, (int16_t*)dst);
+        break;
+    case APP_DOT_NAIVE:        out = (uint32_t)dot_q15_naive(samples, samples + bytes / 4, bytes / 4); break;
+    case APP_DOT_UNROLL:       out = (uint32_t)dot_q15_unrolled(samples, samples + bytes / 4, bytes / 4); break;
+    case APP_SHA256_NAIVE:     sha256_naive(src, bytes, digest); break;
+    case APP_SHA256_UNROLL:    sha256_unrolled(src, bytes, digest); break;
+    case APP_SHA256_MBEDTLS:   ret = mbedtls_sha256(src, bytes, digest, 0); break;
+    case APP_AES_NAIVE:
+        memset(iv, 0, sizeof(iv));
+        aes128_expand_key(&key, k_aes_key);
+        aes128_cbc_naive(&key, iv, src, dst, bytes);
+        break;
+    case APP_AES_TTABLE:
+        memset(iv, 0, sizeof(iv));
+        aes128_expand_key(&key, k_aes_key);
+        aes128_cbc_ttable(&key, iv, src, dst, bytes);
+        break;
+    case APP_AES_MBEDTLS:
+        memset(iv, 0, sizeof(iv));
+        ret = aes128_cbc_mbedtls(iv, src, dst, bytes);
+        break;
+    default:
+        break;
+    }
+    uint32_t end = get_cycle_count();
+
+    if (ret != 0) {
+        printf("Anwendungsbenchmark %s.%s: mbedtls-Fehler -0x%04x\n",
+               k_app_kinds[c->kind].kernel, k_app_kinds[c->kind].variant, (unsigned)-ret);
+        *result = 0;
+        return 0;
+    }
+
+    if (c->kind == APP_SHA256_NAIVE || c->kind == APP_SHA256_UNROLL || c->kind == APP_SHA256_MBEDTLS) {
+        memcpy(&out, digest, sizeof(out));
+    } else if (c->kind >= APP_FIR_NAIVE && c->kind <= APP_FIR_UNROLL) {
+        memcpy(&out, dst, sizeof(out));
+    } else if (c->kind >= APP_AES_NAIVE) {
+        memcpy(&out, dst + bytes - sizeof(out), sizeof(out));
+    }
+    *result = out;
+
+    uint32_t cycles = timing_subtract_overhead(end - start, 0);
+    bench_track_min(&c->best, (float)cycles / bytes);
+    return cycles;
+}
+
+// ============ REGISTRIERUNG ============
+/**
+ * @brief Größe kompakt formatieren (256, 4K, 64K)
+ */
+static void format_size(char* out, size_t len, uint32_t bytes) {
+    if (bytes >= 1024) {
+        snprintf(out, len, "%" PRIu32 "K", bytes / 1024);
+    } else {
+        snprintf(out, len, "%" PRIu32, bytes);
+    }
+}
+
+/**
+ * @brief Registriert alle Kernel x Größen vor app_main()
+ */
+__attribute__((constructor)) static void app_bench_register(void) {
+    for (uint32_t kind = 0; kind < APP_KIND_COUNT; kind++) {
+        for (uint32_t bytes = APP_MIN_BYTES; bytes <= APP_MAX_BYTES && s_case_count < MAX_APP_CASES; bytes *= 4) {
+            app_case_t* c = &s_cases[s_case_count];
+            c->kind = (uint8_t)kind;
+            c->bytes = bytes;
+            c->best = FLT_MAX;
+
+            char size[12];
+            format_size(size, sizeof(size), bytes);
+            snprintf(s_names[s_case_count], MAX_NAME_LEN, "app.%s.%s.%s",
+                     k_app_kinds[kind].kernel, k_app_kinds[kind].variant, size);
+
+            bench_def_t* def = &s_defs[s_case_count];
+            def->name = s_names[s_case_count];
+            def->suite = "app";
+            def->tags = k_app_kinds[kind].tags;
+            def->iterations = bytes;
+            def->granularity = APP_BLOCK_BYTES;
+            def->fn = bench_app;
+            def->arg = c;
+            def->test_id = BENCH_TEST_ID_NONE;
+            bench_register(def);
+            s_case_count++;
+        }
+    }
+}
+
+// ============ REFERENZVEKTOREN ============
+uint32_t app_bench_verify(void) {
+    uint32_t failed = app_kernels_verify();
+
+    // mbedtls (ggf. Beschleuniger) gegen die geprüfte Softwarefassung
+    const uint32_t len = 1024;
+    uint8_t* in = (uint8_t*)malloc(len);
+    uint8_t* sw = (uint8_t*)malloc(len);
+    uint8_t* hw = (uint8_t*)malloc(len);
+    if (in != NULL && sw != NULL && hw != NULL) {
+        for (uint32_t i = 0; i < len; i++) {
+            in[i] = (uint8_t)(i * 31 + 7);
+        }
+
+        uint8_t sw_digest[32], hw_digest[32];
+        sha256_unrolled(in, len - 3, sw_digest);
+        int ret = mbedtls_sha256(in, len - 3, hw_digest, 0);
+        if (ret != 0) {
+            printf("❌ sha256.mbedtls: Fehler -0x%04x\n", (unsigned)-ret);
+            failed++;
+        } else if (memcmp(sw_digest, hw_digest, sizeof(sw_digest)) != 0) {
+            printf("❌ Referenzvektor falsch: sha256.mbedtls (1021 Byte)\n");
+            failed++;
+        }
+
+        uint8_t iv[16] = { 0 };
+        aes128_key_t key;
+        aes128_expand_key(&key, k_aes_key);
+        aes128_cbc_ttable(&key, iv, in, sw, len);
+        memset(iv, 0, sizeof(iv));
+        ret = aes128_cbc_mbedtls(iv, in, hw, len);
+        if (ret != 0) {
+            printf("❌ aes128cbc.mbedtls: Fehler -0x%04x\n", (unsigned)-ret);
+            failed++;
+        } else if (memcmp(sw, hw, len) != 0) {
+            printf("❌ Referenzvektor falsch: aes128cbc.mbedtls (1024 Byte)\n");
+            failed++;
+        }
+    }
+    free(in);
+    free(sw);
+    free(hw);
+
+    if (failed == 0) {
+        printf("✅ Anwendungskernel: alle Referenzvektoren bestanden\n");
+    } else {
+        printf("❌ Anwendungskernel: %" PRIu32 " Prüfungen fehlgeschlagen\n", failed);
+    }
+    return failed;
+}
+
+// ============ AUSGABE ============
+static const app_case_t* find_case(uint32_t kind, uint32_t bytes) {
+    for (uint32_t i = 0; i < s_case_count; i++) {
+        if (s_cases[i].kind == kind && s_cases[i].bytes == bytes) {
+            return &s_cases[i];
+        }
+    }
+    return NULL;
+}
+
+static float case_best(uint32_t kind, uint32_t bytes) {
+    const app_case_t* c = find_case(kind, bytes);
+    return c != NULL ? c->best : FLT_MAX;
+}
+
+/**
+ * @brief Kleinste Größe, ab der mbedtls schneller ist als die beste Softwarevariante
+ */
+static void print_crossover(uint32_t first, uint32_t last, uint32_t hw_kind) {
+    for (uint32_t bytes = APP_MIN_BYTES; bytes <= APP_MAX_BYTES; bytes *= 4) {
+        float hw = case_best(hw_kind, bytes);
+        float sw = FLT_MAX;
+        for (uint32_t kind = first; kind <= last; kind++) {
+            if (kind != hw_kind && case_best(kind, bytes) < sw) {
+                sw = case_best(kind, bytes);
+            }
+        }
+        if (hw < FLT_MAX && sw < FLT_MAX && hw < sw) {
+            char size[12];
+            format_size(size, sizeof(size), bytes);
+            printf("Crossover %s: mbedtls ab %s Byte schneller (%.2f statt %.2f Zyklen/Byte)\n",
+                   k_app_kinds[hw_kind].kernel, size, hw, sw);
+            return;
+        }
+    }
+    printf("Crossover %s: mbedtls in keiner gemessenen Größe schneller\n", k_app_kinds[hw_kind].kernel);
+}
+
+/**
+ * @brief Gibt je Kernel eine Tabelle Größe x Variante (Zyklen pro Byte) aus
+ * Es zählt das Minimum über alle Samples; nicht gemessene Zellen bleiben "-".
+ */
+void app_bench_print_table(void) {
+    uint32_t first = 0;
+    while (first < APP_KIND_COUNT) {
+        uint32_t last = first;
+        while (last + 1 < APP_KIND_COUNT && strcmp(k_app_kinds[last + 1].kernel, k_app_kinds[first].kernel) == 0) {
+            last++;
+        }
+
+        bool measured = false;
+        uint32_t hw_kind = APP_KIND_COUNT;
+        for (uint32_t i = 0; i < s_case_count; i++) {
+            if (s_cases[i].kind >= first && s_cases[i].kind <= last) {
+                measured |= s_cases[i].best < FLT_MAX;
+            }
+        }
+        for (uint32_t kind = first; kind <= last; kind++) {
+            hw_kind = k_app_kinds[kind].mbedtls ? kind : hw_kind;
+        }
+
+        if (measured) {
+            printf("\n=== %s (Zyklen pro Byte, Minimum) ===\n%8s", k_app_kinds[first].kernel, "Groesse");
+            for (uint32_t kind = first; kind <= last; kind++) {
+                printf(" %10s", k_app_kinds[kind].variant);
+            }
+            printf("\n");
+            for (uint32_t bytes = APP_MIN_BYTES; bytes <= APP_MAX_BYTES; bytes *= 4) {
+                char size[12];
+                format_size(size, sizeof(size), bytes);
+                printf("%8s", size);
+                for (uint32_t kind = first; kind <= last; kind++) {
+                    float best = case_best(kind, bytes);
+                    if (best < FLT_MAX) {
+                        printf(" %10.2f", best);
+                    } else {
+                        printf(" %10s", "-");
+                    }
+                }
+                printf("\n");
+            }
+            if (hw_kind < APP_KIND_COUNT) {
+                print_crossover(first, last, hw_kind);
+            }
+        }
+        first = last + 1;
+    }
+}
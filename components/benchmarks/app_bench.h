@@ -0,0 +1,21 @@
+#ifndef APP_BENCH_H
+#define APP_BENCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Prüft Software- und mbedtls-Varianten gegen Referenzvektoren (Ausgabe ✅/❌)
+// und gibt die Anzahl fehlgeschlagener Prüfungen zurück
+uint32_t app_bench_verify(void);
+
+// Größe-über-Zyklen-pro-Byte-Tabellen je Kernel, Crossover mbedtls/Software
+void app_bench_print_table(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
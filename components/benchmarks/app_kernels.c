@@ -0,0 +1,625 @@
+// Anwendungskernel: CRC-32, Fletcher-32, Q15-FIR/Skalarprodukt, SHA-256, AES-128
+//
+// Pro Kernel eine naive Fassung (bitweise bzw. byteweise, Lehrbuchform), eine
+// tabellengesteuerte und eine ausgerollte, wortweise Fassung - soweit der
+// Algorithmus das hergibt:
+//   crc32      naive (bitweise)      table (256 Einträge)   slice4 (4 Tabellen, Wort pro Schritt)
+//   fletcher32 naive (mod pro Wort)  blocked (mod pro Block) word (32-Bit-Loads, ausgerollt)
+//   fir / dot  naive                 -                       unrolled (Registerblockung / Wort-Loads)
+//   sha256     naive (W[64])         -                       unrolled (rollender Plan, 8 Runden)
+//   aes128     naive (byteweise)     ttable (4 T-Tabellen)   -
+// Alle Varianten eines Kernels liefern bitgleiche Ergebnisse (app_kernels_verify).
+
+#include "app_kernels.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// ============ TABELLEN ============
+static uint32_t s_crc_table[4][256];
+static uint32_t s_aes_te[4][256];
+
+static const uint8_t k_aes_sbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+static const uint32_t k_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t rotr32(uint32_t x, unsigned n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+static inline uint32_t load_be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline void store_be32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static inline uint8_t aes_xtime(uint8_t x) {
+    return (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1b : 0x00));
+}
+
+/**
+ * @brief Baut CRC- und AES-Tabellen vor main auf (RAM statt Flash-rodata)
+ */
+__attribute__((constructor)) static void app_kernels_init(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+        s_crc_table[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int t = 1; t < 4; t++) {
+            uint32_t prev = s_crc_table[t - 1][i];
+            s_crc_table[t][i] = (prev >> 8) ^ s_crc_table[0][prev & 0xff];
+        }
+    }
+
+    // Te0[x] = S[x] * (02, 01, 01, 03), Te1..Te3 jeweils um ein Byte rotiert
+    for (uint32_t i = 0; i < 256; i++) {
+        uint8_t s = k_aes_sbox[i];
+        uint8_t s2 = aes_xtime(s);
+        uint32_t te = ((uint32_t)s2 << 24) | ((uint32_t)s << 16) | ((uint32_t)s << 8) | (uint8_t)(s2 ^ s);
+        for (int t = 0; t < 4; t++) {
+            s_aes_te[t][i] = t ? rotr32(te, 8 * t) : te;
+        }
+    }
+}
+
+// ============ CRC-32 ============
+uint32_t crc32_naive(const uint8_t* data, uint32_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+static inline uint32_t crc32_bytes(uint32_t crc, const uint8_t* data, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) {
+        crc = (crc >> 8) ^ s_crc_table[0][(crc ^ data[i]) & 0xff];
+    }
+    return crc;
+}
+
+uint32_t crc32_table(const uint8_t* data, uint32_t len) {
+    return ~crc32_bytes(0xFFFFFFFFu, data, len);
+}
+
+uint32_t crc32_slice4(const uint8_t* data, uint32_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    uint32_t head = (4 - ((uintptr_t)data & 3)) & 3;
+    head = head < len ? head : len;
+    crc = crc32_bytes(crc, data, head);
+    data += head;
+    len -= head;
+
+    // Ein Wort pro Schritt, little-endian wie RISC-V und x86
+    const uint32_t* words = (const uint32_t*)data;
+    for (uint32_t i = 0; i < len / 4; i++) {
+        crc ^= words[i];
+        crc = s_crc_table[3][crc & 0xff] ^ s_crc_table[2][(crc >> 8) & 0xff] ^
+              s_crc_table[1][(crc >> 16) & 0xff] ^ s_crc_table[0][crc >> 24];
+    }
+    return ~crc32_bytes(crc, data + (len & ~3u), len & 3);
+}
+
+// ============ FLETCHER-32 ============
+#define FLETCHER_BLOCK_WORDS    359     // Größte Blocklänge ohne 32-Bit-Überlauf
+
+uint32_t fletcher32_naive(const uint8_t* data, uint32_t len) {
+    uint32_t sum1 = 0, sum2 = 0;
+    for (uint32_t i = 0; i < len; i += 2) {
+        uint32_t word = data[i] | (i + 1 < len ? (uint32_t)data[i + 1] << 8 : 0);
+        sum1 = (sum1 + word) % 65535;
+        sum2 = (sum2 + sum1) % 65535;
+    }
+    return (sum2 << 16) | sum1;
+}
+
+/**
+ * @brief Fletcher-32 ab gegebenen Teilsummen, Modulo nur einmal pro Block
+ */
+static uint32_t fletcher32_continue(uint32_t sum1, uint32_t sum2, const uint8_t* data, uint32_t len) {
+    uint32_t words = (len + 1) / 2;
+    uint32_t i = 0;
+    while (words > 0) {
+        uint32_t block = words < FLETCHER_BLOCK_WORDS ? words : FLETCHER_BLOCK_WORDS;
+        words -= block;
+        for (; block > 0; block--, i += 2) {
+            sum1 += data[i] | (i + 1 < len ? (uint32_t)data[i + 1] << 8 : 0);
+            sum2 += sum1;
+        }
+        sum1 %= 65535;
+        sum2 %= 65535;
+    }
+    return (sum2 << 16) | sum1;
+}
+
+uint32_t fletcher32_blocked(const uint8_t* data, uint32_t len) {
+    return fletcher32_continue(0, 0, data, len);
+}
+
+uint32_t fletcher32_word(const uint8_t* data, uint32_t len) {
+    if ((uintptr_t)data & 3) {
+        return fletcher32_blocked(data, len);
+    }
+    // Zwei Wörter pro Load, zwei Loads pro Durchlauf; Block = 356 Wörter
+    const uint32_t* words = (const uint32_t*)data;
+    uint32_t pairs = len / 8;
+    uint32_t sum1 = 0, sum2 = 0;
+    while (pairs > 0) {
+        uint32_t block = pairs < FLETCHER_BLOCK_WORDS / 4 ? pairs : FLETCHER_BLOCK_WORDS / 4;
+        pairs -= block;
+        for (; block > 0; block--, words += 2) {
+            uint32_t w0 = words[0], w1 = words[1];
+            sum1 += w0 & 0xffff;
+            sum2 += sum1;
+            sum1 += w0 >> 16;
+            sum2 += sum1;
+            sum1 += w1 & 0xffff;
+            sum2 += sum1;
+            sum1 += w1 >> 16;
+            sum2 += sum1;
+        }
+        sum1 %= 65535;
+        sum2 %= 65535;
+    }
+    return fletcher32_continue(sum1, sum2, (const uint8_t*)words, len & 7);
+}
+
+// ============ FESTKOMMA-DSP ============
+void fir_q15_naive(const int16_t* x, uint32_t n, const int16_t* h, uint32_t taps, int16_t* y) {
+    if (n < taps) {
+        return;
+    }
+    for (uint32_t i = 0; i <= n - taps; i++) {
+        int32_t acc = 0;
+        for (uint32_t k = 0; k < taps; k++) {
+            acc += (int32_t)h[k] * x[i + k];
+        }
+        y[i] = (int16_t)(acc >> 15);
+    }
+}
+
+void fir_q15_unrolled(const int16_t* x, uint32_t n, const int16_t* h, uint32_t taps, int16_t* y) {
+    if (n < taps) {
+        return;
+    }
+    const uint32_t outputs = n - taps + 1;
+    uint32_t i = 0;
+    // Vier Ausgänge pro Durchlauf: ein Koeffizient und ein neues Sample pro
+    // Tap, die übrigen Samples rotieren in Registern
+    for (; i + 4 <= outputs; i += 4) {
+        const int16_t* p = x + i;
+        int32_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+        int32_t x0 = p[0], x1 = p[1], x2 = p[2];
+        for (uint32_t k = 0; k < taps; k++) {
+            int32_t c = h[k];
+            int32_t x3 = p[k + 3];
+            acc0 += c * x0;
+            acc1 += c * x1;
+            acc2 += c * x2;
+            acc3 += c * x3;
+            x0 = x1;
+            x1 = x2;
+            x2 = x3;
+        }
+        y[i + 0] = (int16_t)(acc0 >> 15);
+        y[i + 1] = (int16_t)(acc1 >> 15);
+        y[i + 2] = (int16_t)(acc2 >> 15);
+        y[i + 3] = (int16_t)(acc3 >> 15);
+    }
+    if (i < outputs) {
+        fir_q15_naive(x + i, n - i, h, taps, y + i);
+    }
+}
+
+int32_t dot_q15_naive(const int16_t* a, const int16_t* b, uint32_t n) {
+    int32_t acc = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += ((int32_t)a[i] * b[i]) >> 15;
+    }
+    return acc;
+}
+
+int32_t dot_q15_unrolled(const int16_t* a, const int16_t* b, uint32_t n) {
+    if (((uintptr_t)a | (uintptr_t)b) & 3) {
+        return dot_q15_naive(a, b, n);
+    }
+    // Zwei Samples pro Wort-Load, vier Wörter und Teilsummen pro Durchlauf
+    const uint32_t* wa = (const uint32_t*)a;
+    const uint32_t* wb = (const uint32_t*)b;
+    int32_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8, wa += 4, wb += 4) {
+        uint32_t a0 = wa[0], a1 = wa[1], a2 = wa[2], a3 = wa[3];
+        uint32_t b0 = wb[0], b1 = wb[1], b2 = wb[2], b3 = wb[3];
+        acc0 += ((int32_t)(int16_t)a0 * (int16_t)b0) >> 15;
+        acc0 += ((int32_t)a0 >> 16) * ((int32_t)b0 >> 16) >> 15;
+        acc1 += ((int32_t)(int16_t)a1 * (int16_t)b1) >> 15;
+        acc1 += ((int32_t)a1 >> 16) * ((int32_t)b1 >> 16) >> 15;
+        acc2 += ((int32_t)(int16_t)a2 * (int16_t)b2) >> 15;
+        acc2 += ((int32_t)a2 >> 16) * ((int32_t)b2 >> 16) >> 15;
+        acc3 += ((int32_t)(int16_t)a3 * (int16_t)b3) >> 15;
+        acc3 += ((int32_t)a3 >> 16) * ((int32_t)b3 >> 16) >> 15;
+    }
+    return acc0 + acc1 + acc2 + acc3 + dot_q15_naive(a + i, b + i, n - i);
+}
+
+// ============ SHA-256 ============
+#define SHA_CH(x, y, z)     (((x) & (y)) ^ (~(x) & (z)))
+#define SHA_MAJ(x, y, z)    (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define SHA_S0(x)           (rotr32(x, 2) ^ rotr32(x, 13) ^ rotr32(x, 22))
+#define SHA_S1(x)           (rotr32(x, 6) ^ rotr32(x, 11) ^ rotr32(x, 25))
+#define SHA_G0(x)           (rotr32(x, 7) ^ rotr32(x, 18) ^ ((x) >> 3))
+#define SHA_G1(x)           (rotr32(x, 17) ^ rotr32(x, 19) ^ ((x) >> 10))
+
+typedef void (*sha256_block_fn)(uint32_t state[8], const uint8_t* block);
+
+static void sha256_block_naive(uint32_t state[8], const uint8_t* block) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = load_be32(block + 4 * i);
+    }
+    for (int i = 16; i < 64; i++) {
+        w[i] = SHA_G1(w[i - 2]) + w[i - 7] + SHA_G0(w[i - 15]) + w[i - 16];
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = h + SHA_S1(e) + SHA_CH(e, f, g) + k_sha256_k[i] + w[i];
+        uint32_t t2 = SHA_S0(a) + SHA_MAJ(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+// Eine Runde mit umbenannten Variablen statt Verschieben; W[i] aus dem
+// rollenden 16-Wort-Plan, ab Runde 16 an Ort und Stelle fortgeschrieben
+#define SHA_W(i)            w[(i) & 15]
+#define SHA_EXPAND(i)       (SHA_W(i) += SHA_G1(SHA_W((i) - 2)) + SHA_W((i) - 7) + SHA_G0(SHA_W((i) - 15)))
+#define SHA_ROUND(a, b, c, d, e, f, g, h, i, wi) do { \
+        uint32_t t1 = h + SHA_S1(e) + SHA_CH(e, f, g) + k_sha256_k[i] + (wi); \
+        d += t1; \
+        h = t1 + SHA_S0(a) + SHA_MAJ(a, b, c); \
+    } while (0)
+#define SHA_ROUNDS8(i, W) \
+    SHA_ROUND(a, b, c, d, e, f, g, h, (i) + 0, W((i) + 0)); \
+    SHA_ROUND(h, a, b, c, d, e, f, g, (i) + 1, W((i) + 1)); \
+    SHA_ROUND(g, h, a, b, c, d, e, f, (i) + 2, W((i) + 2)); \
+    SHA_ROUND(f, g, h, a, b, c, d, e, (i) + 3, W((i) + 3)); \
+    SHA_ROUND(e, f, g, h, a, b, c, d, (i) + 4, W((i) + 4)); \
+    SHA_ROUND(d, e, f, g, h, a, b, c, (i) + 5, W((i) + 5)); \
+    SHA_ROUND(c, d, e, f, g, h, a, b, (i) + 6, W((i) + 6)); \
+    SHA_ROUND(b, c, d, e, f, g, h, a, (i) + 7, W((i) + 7))
+
+static void sha256_block_unrolled(uint32_t state[8], const uint8_t* block) {
+    uint32_t w[16];
+    for (int i = 0; i < 16; i++) {
+        w[i] = load_be32(block + 4 * i);
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 16; i += 8) {
+        SHA_ROUNDS8(i, SHA_W);
+    }
+    for (int i = 16; i < 64; i += 8) {
+        SHA_ROUNDS8(i, SHA_EXPAND);
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+/**
+ * @brief Vollständiger Hash inklusive Padding, Blockfunktion austauschbar
+ */
+static void sha256_run(const uint8_t* data, uint32_t len, uint8_t digest[32], sha256_block_fn block) {
+    uint32_t state[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    uint32_t full = len & ~63u;
+    for (uint32_t off = 0; off < full; off += 64) {
+        block(state, data + off);
+    }
+
+    uint8_t tail[128] = { 0 };
+    uint32_t rest = len - full;
+    uint32_t tail_len = rest < 56 ? 64 : 128;
+    memcpy(tail, data + full, rest);
+    tail[rest] = 0x80;
+    store_be32(tail + tail_len - 8, len >> 29);
+    store_be32(tail + tail_len - 4, len << 3);
+    block(state, tail);
+    if (tail_len == 128) {
+        block(state, tail + 64);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        store_be32(digest + 4 * i, state[i]);
+    }
+}
+
+void sha256_naive(const uint8_t* data, uint32_t len, uint8_t digest[32]) {
+    sha256_run(data, len, digest, sha256_block_naive);
+}
+
+void sha256_unrolled(const uint8_t* data, uint32_t len, uint8_t digest[32]) {
+    sha256_run(data, len, digest, sha256_block_unrolled);
+}
+
+// ============ AES-128 ============
+static inline uint32_t aes_sub_word(uint32_t w) {
+    return ((uint32_t)k_aes_sbox[w >> 24] << 24) | ((uint32_t)k_aes_sbox[(w >> 16) & 0xff] << 16) |
+           ((uint32_t)k_aes_sbox[(w >> 8) & 0xff] << 8) | k_aes_sbox[w & 0xff];
+}
+
+void aes128_expand_key(aes128_key_t* key, const uint8_t raw[16]) {
+    static const uint8_t rcon[10] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36 };
+    for (int i = 0; i < 4; i++) {
+        key->rk[i] = load_be32(raw + 4 * i);
+    }
+    for (int i = 4; i < 44; i++) {
+        uint32_t temp = key->rk[i - 1];
+        if (i % 4 == 0) {
+            temp = aes_sub_word(rotr32(temp, 24)) ^ ((uint32_t)rcon[i / 4 - 1] << 24);
+        }
+        key->rk[i] = key->rk[i - 4] ^ temp;
+    }
+}
+
+/**
+ * @brief Ein Block, Lehrbuchform: SubBytes, ShiftRows, MixColumns byteweise
+ * Zustand spaltenweise wie die Eingabe: s[4 * Spalte + Zeile]
+ */
+static void aes128_block_naive(const aes128_key_t* key, uint8_t s[16]) {
+    for (int round = 0; round <= 10; round++) {
+        if (round > 0) {
+            uint8_t t[16];
+            for (int i = 0; i < 16; i++) {
+                s[i] = k_aes_sbox[s[i]];
+            }
+            for (int col = 0; col < 4; col++) {
+                for (int row = 0; row < 4; row++) {
+                    t[4 * col + row] = s[4 * ((col + row) % 4) + row];
+                }
+            }
+            if (round < 10) {
+                for (int col = 0; col < 4; col++) {
+                    uint8_t* a = &t[4 * col];
+                    uint8_t all = a[0] ^ a[1] ^ a[2] ^ a[3];
+                    uint8_t a0 = a[0];
+                    a[0] ^= all ^ aes_xtime(a[0] ^ a[1]);
+                    a[1] ^= all ^ aes_xtime(a[1] ^ a[2]);
+                    a[2] ^= all ^ aes_xtime(a[2] ^ a[3]);
+                    a[3] ^= all ^ aes_xtime(a[3] ^ a0);
+                }
+            }
+            memcpy(s, t, 16);
+        }
+        for (int col = 0; col < 4; col++) {
+            uint32_t rk = key->rk[4 * round + col];
+            s[4 * col + 0] ^= (uint8_t)(rk >> 24);
+            s[4 * col + 1] ^= (uint8_t)(rk >> 16);
+            s[4 * col + 2] ^= (uint8_t)(rk >> 8);
+            s[4 * col + 3] ^= (uint8_t)rk;
+        }
+    }
+}
+
+/**
+ * @brief Ein Block über T-Tabellen: pro Runde 16 Tabellenzugriffe und XOR
+ */
+static void aes128_block_ttable(const aes128_key_t* key, uint8_t block[16]) {
+    const uint32_t* rk = key->rk;
+    uint32_t s0 = load_be32(block + 0) ^ rk[0];
+    uint32_t s1 = load_be32(block + 4) ^ rk[1];
+    uint32_t s2 = load_be32(block + 8) ^ rk[2];
+    uint32_t s3 = load_be32(block + 12) ^ rk[3];
+
+    for (int round = 1; round < 10; round++) {
+        rk += 4;
+        uint32_t t0 = s_aes_te[0][s0 >> 24] ^ s_aes_te[1][(s1 >> 16) & 0xff] ^
+                      s_aes_te[2][(s2 >> 8) & 0xff] ^ s_aes_te[3][s3 & 0xff] ^ rk[0];
+        uint32_t t1 = s_aes_te[0][s1 >> 24] ^ s_aes_te[1][(s2 >> 16) & 0xff] ^
+                      s_aes_te[2][(s3 >> 8) & 0xff] ^ s_aes_te[3][s0 & 0xff] ^ rk[1];
+        uint32_t t2 = s_aes_te[0][s2 >> 24] ^ s_aes_te[1][(s3 >> 16) & 0xff] ^
+                      s_aes_te[2][(s0 >> 8) & 0xff] ^ s_aes_te[3][s1 & 0xff] ^ rk[2];
+        uint32_t t3 = s_aes_te[0][s3 >> 24] ^ s_aes_te[1][(s0 >> 16) & 0xff] ^
+                      s_aes_te[2][(s1 >> 8) & 0xff] ^ s_aes_te[3][s2 & 0xff] ^ rk[3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    // Letzte Runde ohne MixColumns: nur S-Box und ShiftRows
+    rk += 4;
+    store_be32(block + 0, aes_sub_word((s0 & 0xff000000) | (s1 & 0x00ff0000) | (s2 & 0x0000ff00) | (s3 & 0xff)) ^ rk[0]);
+    store_be32(block + 4, aes_sub_word((s1 & 0xff000000) | (s2 & 0x00ff0000) | (s3 & 0x0000ff00) | (s0 & 0xff)) ^ rk[1]);
+    store_be32(block + 8, aes_sub_word((s2 & 0xff000000) | (s3 & 0x00ff0000) | (s0 & 0x0000ff00) | (s1 & 0xff)) ^ rk[2]);
+    store_be32(block + 12, aes_sub_word((s3 & 0xff000000) | (s0 & 0x00ff0000) | (s1 & 0x0000ff00) | (s2 & 0xff)) ^ rk[3]);
+}
+
+typedef void (*aes128_block_fn)(const aes128_key_t* key, uint8_t block[16]);
+
+static void aes128_cbc(const aes128_key_t* key, uint8_t iv[16], const uint8_t* in, uint8_t* out, uint32_t len,
+                       aes128_block_fn block) {
+    for (uint32_t off = 0; off + 16 <= len; off += 16) {
+        for (int i = 0; i < 16; i++) {
+            iv[i] ^= in[off + i];
+        }
+        block(key, iv);
+        memcpy(out + off, iv, 16);
+    }
+}
+
+void aes128_cbc_naive(const aes128_key_t* key, uint8_t iv[16], const uint8_t* in, uint8_t* out, uint32_t len) {
+    aes128_cbc(key, iv, in, out, len, aes128_block_naive);
+}
+
+void aes128_cbc_ttable(const aes128_key_t* key, uint8_t iv[16], const uint8_t* in, uint8_t* out, uint32_t len) {
+    aes128_cbc(key, iv, in, out, len, aes128_block_ttable);
+}
+
+// ============ REFERENZVEKTOREN ============
+/**
+ * @brief Hex-String in Bytes (nur für die Referenzvektoren)
+ */
+static uint32_t from_hex(uint8_t* out, const char* hex) {
+    uint32_t n = 0;
+    for (; hex[0] && hex[1]; hex += 2) {
+        char pair[3] = { hex[0], hex[1], 0 };
+        unsigned value;
+        sscanf(pair, "%02x", &value);
+        out[n++] = (uint8_t)value;
+    }
+    return n;
+}
+
+static uint32_t check(const char* kernel, const char* variant, const char* vector, bool ok) {
+    if (!ok) {
+        printf("❌ Referenzvektor falsch: %s.%s (%s)\n", kernel, variant, vector);
+    }
+    return ok ? 0 : 1;
+}
+
+uint32_t app_kernels_verify(void) {
+    uint32_t failed = 0;
+
+    // CRC-32 Check-Wert
+    static const uint8_t crc_msg[] = "123456789";
+    failed += check("crc32", "naive", "123456789", crc32_naive(crc_msg, 9) == 0xCBF43926u);
+    failed += check("crc32", "table", "123456789", crc32_table(crc_msg, 9) == 0xCBF43926u);
+    failed += check("crc32", "slice4", "123456789", crc32_slice4(crc_msg, 9) == 0xCBF43926u);
+
+    static const struct { const char* msg; uint32_t sum; } fletcher[] = {
+        { "abcde", 0xF04FC729u }, { "abcdef", 0x56502D2Au }, { "abcdefgh", 0xEBE19591u },
+    };
+    for (size_t i = 0; i < sizeof(fletcher) / sizeof(fletcher[0]); i++) {
+        uint32_t words[4] = { 0 };      // Ausgerichtet für fletcher32_word
+        uint32_t len = (uint32_t)strlen(fletcher[i].msg);
+        memcpy(words, fletcher[i].msg, len);
+        failed += check("fletcher32", "naive", fletcher[i].msg, fletcher32_naive((const uint8_t*)words, len) == fletcher[i].sum);
+        failed += check("fletcher32", "blocked", fletcher[i].msg, fletcher32_blocked((const uint8_t*)words, len) == fletcher[i].sum);
+        failed += check("fletcher32", "word", fletcher[i].msg, fletcher32_word((const uint8_t*)words, len) == fletcher[i].sum);
+    }
+
+    // Lange Eingabe: Blockgrenzen der Modulo-Reduktion und Wortpfad
+    const uint32_t bulk_len = 4100;
+    uint8_t* bulk = (uint8_t*)malloc(bulk_len);
+    if (bulk != NULL) {
+        for (uint32_t i = 0; i < bulk_len; i++) {
+            bulk[i] = (uint8_t)(i * 167 + 13);
+        }
+        failed += check("crc32", "table", "4100 Byte", crc32_table(bulk, bulk_len) == crc32_naive(bulk, bulk_len));
+        failed += check("crc32", "slice4", "4099 Byte", crc32_slice4(bulk + 1, bulk_len - 1) == crc32_naive(bulk + 1, bulk_len - 1));
+        failed += check("fletcher32", "blocked", "4100 Byte", fletcher32_blocked(bulk, bulk_len) == fletcher32_naive(bulk, bulk_len));
+        failed += check("fletcher32", "word", "4099 Byte", fletcher32_word(bulk, bulk_len - 1) == fletcher32_naive(bulk, bulk_len - 1));
+        free(bulk);
+    }
+
+    // Q15: Mittelwert zweier Samples, Skalarprodukt mit Vorzeichen und Rest
+    static const int16_t fir_h[2] = { 16384, 16384 };
+    static const int16_t fir_x[9] = { 2, 4, 6, 8, -10, 12, 14, 16, 18 };
+    static const int16_t fir_ref[8] = { 3, 5, 7, -1, 1, 13, 15, 17 };
+    int16_t fir_y[8];
+    fir_q15_naive(fir_x, 9, fir_h, 2, fir_y);
+    failed += check("fir", "naive", "Mittelwert", memcmp(fir_y, fir_ref, sizeof(fir_ref)) == 0);
+    memset(fir_y, 0, sizeof(fir_y));
+    fir_q15_unrolled(fir_x, 9, fir_h, 2, fir_y);
+    failed += check("fir", "unroll", "Mittelwert", memcmp(fir_y, fir_ref, sizeof(fir_ref)) == 0);
+
+    static const int16_t dot_a[9] __attribute__((aligned(4))) = { 16384, -16384, 32767, 0, 0, 0, 0, 0, 16384 };
+    static const int16_t dot_b[9] __attribute__((aligned(4))) = { 16384, 16384, 2, 7, 7, 7, 7, 7, -32768 };
+    failed += check("dot", "naive", "9 Samples", dot_q15_naive(dot_a, dot_b, 9) == 1 - 16384);
+    failed += check("dot", "unroll", "9 Samples", dot_q15_unrolled(dot_a, dot_b, 9) == 1 - 16384);
+
+    // FIPS 180-2: "abc", leere Nachricht, Zwei-Block-Padding
+    static const struct { const char* msg; const char* digest; } sha[] = {
+        { "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+        { "", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+        { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+          "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" },
+    };
+    for (size_t i = 0; i < sizeof(sha) / sizeof(sha[0]); i++) {
+        uint8_t expected[32], digest[32];
+        from_hex(expected, sha[i].digest);
+        uint32_t len = (uint32_t)strlen(sha[i].msg);
+        sha256_naive((const uint8_t*)sha[i].msg, len, digest);
+        failed += check("sha256", "naive", sha[i].msg[0] ? sha[i].msg : "\"\"", memcmp(digest, expected, 32) == 0);
+        sha256_unrolled((const uint8_t*)sha[i].msg, len, digest);
+        failed += check("sha256", "unroll", sha[i].msg[0] ? sha[i].msg : "\"\"", memcmp(digest, expected, 32) == 0);
+    }
+
+    // FIPS 197 Anhang C.1 (ECB = CBC mit Null-IV), SP 800-38A F.2.1 (CBC, zwei Blöcke)
+    static const struct { const char* name; const char* key; const char* iv; const char* pt; const char* ct; } aes[] = {
+        { "FIPS-197 C.1", "000102030405060708090a0b0c0d0e0f", "00000000000000000000000000000000",
+          "00112233445566778899aabbccddeeff", "69c4e0d86a7b0430d8cdb78070b4c55a" },
+        { "SP800-38A F.2.1", "2b7e151628aed2a6abf7158809cf4f3c", "000102030405060708090a0b0c0d0e0f",
+          "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51",
+          "7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2" },
+    };
+    for (size_t i = 0; i < sizeof(aes) / sizeof(aes[0]); i++) {
+        uint8_t raw[16], iv[16], pt[32], ct[32], out[32];
+        aes128_key_t key;
+        from_hex(raw, aes[i].key);
+        uint32_t len = from_hex(pt, aes[i].pt);
+        from_hex(ct, aes[i].ct);
+        aes128_expand_key(&key, raw);
+
+        from_hex(iv, aes[i].iv);
+        aes128_cbc_naive(&key, iv, pt, out, len);
+        failed += check("aes128cbc", "naive", aes[i].name, memcmp(out, ct, len) == 0);
+        from_hex(iv, aes[i].iv);
+        aes128_cbc_ttable(&key, iv, pt, out, len);
+        failed += check("aes128cbc", "ttable", aes[i].name, memcmp(out, ct, len) == 0);
+    }
+
+    return failed;
+}
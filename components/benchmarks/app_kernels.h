@@ -0,0 +1,62 @@
+#ifndef APP_KERNELS_H
+#define APP_KERNELS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Anwendungskernel in Software, je Kernel mehrere Implementierungen mit
+// identischem Ergebnis. Portabel (auch linux-Target), Tabellen liegen im RAM
+// und werden vor main aufgebaut. Wortweise Varianten erwarten
+// 4-Byte-ausgerichtete Puffer und fallen sonst auf die Bytevariante zurück.
+
+// ============ CRC-32 ============
+// IEEE 802.3 (reflektiert, Polynom 0xEDB88320, Start/Ende invertiert)
+uint32_t crc32_naive(const uint8_t* data, uint32_t len);
+uint32_t crc32_table(const uint8_t* data, uint32_t len);
+uint32_t crc32_slice4(const uint8_t* data, uint32_t len);
+
+// ============ FLETCHER-32 ============
+// 16-Bit-Wörter little-endian, ungerade Länge mit Nullbyte aufgefüllt
+uint32_t fletcher32_naive(const uint8_t* data, uint32_t len);
+uint32_t fletcher32_blocked(const uint8_t* data, uint32_t len);
+uint32_t fletcher32_word(const uint8_t* data, uint32_t len);
+
+// ============ FESTKOMMA-DSP ============
+// Q15, gültige Faltung: y[i] = (sum h[k] * x[i + k]) >> 15 für i < n - taps + 1.
+// Die Summe der Koeffizientenbeträge muss unter 1.0 liegen (kein Überlauf).
+void fir_q15_naive(const int16_t* x, uint32_t n, const int16_t* h, uint32_t taps, int16_t* y);
+void fir_q15_unrolled(const int16_t* x, uint32_t n, const int16_t* h, uint32_t taps, int16_t* y);
+// Skalarprodukt, jedes Produkt vor dem Aufsummieren auf Q15 geschoben
+int32_t dot_q15_naive(const int16_t* a, const int16_t* b, uint32_t n);
+int32_t dot_q15_unrolled(const int16_t* a, const int16_t* b, uint32_t n);
+
+// ============ SHA-256 ============
+void sha256_naive(const uint8_t* data, uint32_t len, uint8_t digest[32]);
+void sha256_unrolled(const uint8_t* data, uint32_t len, uint8_t digest[32]);
+
+// ============ AES-128 ============
+typedef struct {
+    uint32_t rk[44];            // Rundenschlüssel, Wörter big-endian
+} aes128_key_t;
+
+void aes128_expand_key(aes128_key_t* key, const uint8_t raw[16]);
+// CBC-Verschlüsselung, len Vielfaches von 16, in == out erlaubt
+void aes128_cbc_naive(const aes128_key_t* key, uint8_t iv[16], const uint8_t* in, uint8_t* out, uint32_t len);
+void aes128_cbc_ttable(const aes128_key_t* key, uint8_t iv[16], const uint8_t* in, uint8_t* out, uint32_t len);
+
+// ============ REFERENZVEKTOREN ============
+/**
+ * @brief Prüft alle Softwarevarianten gegen Referenzvektoren
+ * (CRC-32 "123456789", Fletcher-32, FIPS 180-2, FIPS 197, SP 800-38A)
+ * @return Anzahl fehlgeschlagener Prüfungen
+ */
+uint32_t app_kernels_verify(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
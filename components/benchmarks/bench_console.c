@@ -0,0 +1,248 @@
+#include "bench_registry.h"
+#include "result_log.h"
+#include "pmu.h"
+#include "trace.h"
+#include <stdio.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "esp_console.h"
+#include "argtable3/argtable3.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// ============ KONFIGURATION ============
+#define CONSOLE_PROMPT          "bench> "
+#define CONSOLE_LINE_MAX        256
+#define CONSOLE_TASK_STACK      8192
+
+// ============ BEFEHL "bench" ============
+static struct {
+    struct arg_lit* list;
+    struct arg_str* filter;
+    struct arg_int* repeat;
+    struct arg_int* iterations;
+    struct arg_str* pmu;
+    struct arg_end* end;
+} s_bench_args;
+
+/**
+ * @brief bench [-l] [-f <filter>] [-n <repeat>] [-i <iterations>] [-p <ereignisse>]
+ */
+static int cmd_bench(int argc, char** argv) {
+    if (arg_parse(argc, argv, (void**)&s_bench_args) != 0) {
+        arg_print_errors(stderr, s_bench_args.end, argv[0]);
+        return 1;
+    }
+
+    bench_run_spec_t spec;
+    bench_run_spec_default(&spec);
+    if (s_bench_args.filter->count > 0) {
+        spec.filter = s_bench_args.filter->sval[0];
+    }
+    if (s_bench_args.repeat->count > 0) {
+        if (s_bench_args.repeat->ival[0] <= 0) {
+            printf("Ungültige Anzahl Durchläufe: %d (muss > 0 sein)\n", s_bench_args.repeat->ival[0]);
+            return 1;
+        }
+        spec.repeat = (uint32_t)s_bench_args.repeat->ival[0];
+    }
+    if (s_bench_args.iterations->count > 0) {
+        if (s_bench_args.iterations->ival[0] <= 0) {
+            printf("Ungültige Iterationszahl: %d (muss > 0 sein)\n", s_bench_args.iterations->ival[0]);
+            return 1;
+        }
+        spec.iterations = (uint32_t)s_bench_args.iterations->ival[0];
+    }
+    if (s_bench_args.pmu->count > 0) {
+        spec.pmu_events = pmu_parse_events(s_bench_args.pmu->sval[0]);
+        if (spec.pmu_events != 0 && !pmu_available()) {
+            printf("PMU nicht verfügbar, Ereignisse werden ignoriert\n");
+        }
+    }
+
+    if (s_bench_args.list->count > 0) {
+        return bench_list(spec.filter) > 0 ? 0 : 1;
+    }
+    return bench_run(&spec) > 0 ? 0 : 1;
+}
+
+/**
+ * @brief Registriert den Befehl "bench" beim esp_console
+ */
+static void register_bench_command(void) {
+    s_bench_args.list = arg_lit0("l", "list", "Nur auflisten, nicht messen");
+    s_bench_args.filter = arg_str0("f", "filter", "<glob,...>", "Name, Suite oder Tag (z. B. micro,mul*,latency)");
+    s_bench_args.repeat = arg_int0("n", "repeat", "<n>", "Durchläufe über die Auswahl");
+    s_bench_args.iterations = arg_int0("i", "iterations", "<n>", "Operationen pro Sample (ohne -i: Standard des Benchmarks)");
+    s_bench_args.pmu = arg_str0("p", "pmu", "<ereignis,...>", "PMU-Ereignisse oder Sätze (ipc, stalls, mem, branch, all)");
+    s_bench_args.end = arg_end(5);
+
+    const esp_console_cmd_t cmd = {
+        .command = "bench",
+        .help = "Benchmarks auflisten oder gefiltert ausführen",
+        .hint = NULL,
+        .func = cmd_bench,
+        .argtable = &s_bench_args,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+}
+
+#if CONFIG_BENCH_TRACE
+// ============ BEFEHL "trace" ============
+static struct {
+    struct arg_lit* clear;
+    struct arg_end* end;
+} s_trace_args;
+
+/**
+ * @brief trace [-c] - Trace-Puffer ausgeben bzw. leeren
+ */
+static int cmd_trace(int argc, char** argv) {
+    if (arg_parse(argc, argv, (void**)&s_trace_args) != 0) {
+        arg_print_errors(stderr, s_trace_args.end, argv[0]);
+        return 1;
+    }
+    if (s_trace_args.clear->count > 0) {
+        trace_clear();
+    } else {
+        trace_dump();
+    }
+    return 0;
+}
+
+static void register_trace_command(void) {
+    s_trace_args.clear = arg_lit0("c", "clear", "Puffer leeren statt ausgeben");
+    s_trace_args.end = arg_end(1);
+
+    const esp_console_cmd_t cmd = {
+        .command = "trace",
+        .help = "Trace-Puffer ausgeben (scripts/trace_to_json.py) oder leeren",
+        .hint = NULL,
+        .func = cmd_trace,
+        .argtable = &s_trace_args,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+}
+#endif
+
+#if CONFIG_BENCH_RESULT_LOG
+// ============ BEFEHL "log" ============
+static struct {
+    struct arg_lit* dump;
+    struct arg_int* boot;
+    struct arg_lit* erase;
+    struct arg_end* end;
+} s_log_args;
+
+/**
+ * @brief log [-d [-b <sitzung>]] [-e] - Ergebnislog anzeigen, ausgeben oder löschen
+ */
+static int cmd_log(int argc, char** argv) {
+    if (arg_parse(argc, argv, (void**)&s_log_args) != 0) {
+        arg_print_errors(stderr, s_log_args.end, argv[0]);
+        return 1;
+    }
+    if (s_log_args.erase->count > 0) {
+        return result_log_erase() ? 0 : 1;
+    }
+    if (s_log_args.dump->count > 0) {
+        int32_t boot = s_log_args.boot->count > 0 ? s_log_args.boot->ival[0] : -1;
+        result_log_dump(boot);
+        return 0;
+    }
+    result_log_status();
+    return 0;
+}
+
+static void register_log_command(void) {
+    s_log_args.dump = arg_lit0("d", "dump", "Einträge als Binärframes ausgeben (scripts/serial_logger.py)");
+    s_log_args.boot = arg_int0("b", "boot", "<n>", "Nur diese Sitzung ausgeben");
+    s_log_args.erase = arg_lit0("e", "erase", "Partition löschen");
+    s_log_args.end = arg_end(3);
+
+    const esp_console_cmd_t cmd = {
+        .command = "log",
+        .help = "Ergebnislog im Flash: Zustand, Ausgabe (-d) oder Löschen (-e)",
+        .hint = NULL,
+        .func = cmd_log,
+        .argtable = &s_log_args,
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+}
+#endif
+
+#if CONFIG_IDF_TARGET_LINUX
+/**
+ * @brief Einfache Zeilen-REPL auf stdin für das linux-Target
+ */
+static void console_task(void* arg) {
+    (void)arg;
+    char line[CONSOLE_LINE_MAX];
+
+    while (1) {
+        printf(CONSOLE_PROMPT);
+        fflush(stdout);
+        if (fgets(line, sizeof(line), stdin) == NULL) {
+            break;
+        }
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0') {
+            continue;
+        }
+
+        int ret = 0;
+        esp_err_t err = esp_console_run(line, &ret);
+        if (err == ESP_ERR_NOT_FOUND) {
+            printf("Unbekannter Befehl: %s\n", line);
+        } else if (err == ESP_OK && ret != 0) {
+            printf("Befehl fehlgeschlagen: %d\n", ret);
+        }
+    }
+    vTaskDelete(NULL);
+}
+#endif
+
+/**
+ * @brief Startet die Konsole mit dem Befehl "bench" (kehrt sofort zurück)
+ */
+void bench_console_start(void) {
+#if CONFIG_IDF_TARGET_LINUX
+    esp_console_config_t console_config = ESP_CONSOLE_CONFIG_DEFAULT();
+    ESP_ERROR_CHECK(esp_console_init(&console_config));
+    esp_console_register_help_command();
+    register_bench_command();
+#if CONFIG_BENCH_TRACE
+    register_trace_command();
+#endif
+#if CONFIG_BENCH_RESULT_LOG
+    register_log_command();
+#endif
+    xTaskCreate(console_task, "bench_console", CONSOLE_TASK_STACK, NULL, tskIDLE_PRIORITY + 1, NULL);
+#else
+    esp_console_repl_t* repl = NULL;
+    esp_console_repl_config_t repl_config = ESP_CONSOLE_REPL_CONFIG_DEFAULT();
+    repl_config.prompt = CONSOLE_PROMPT;
+    repl_config.max_cmdline_length = CONSOLE_LINE_MAX;
+    repl_config.task_stack_size = CONSOLE_TASK_STACK;
+
+#if defined(CONFIG_ESP_CONSOLE_UART_DEFAULT) || defined(CONFIG_ESP_CONSOLE_UART_CUSTOM)
+    esp_console_dev_uart_config_t hw_config = ESP_CONSOLE_DEV_UART_CONFIG_DEFAULT();
+    ESP_ERROR_CHECK(esp_console_new_repl_uart(&hw_config, &repl_config, &repl));
+#elif defined(CONFIG_ESP_CONSOLE_USB_SERIAL_JTAG)
+    esp_console_dev_usb_serial_jtag_config_t hw_config = ESP_CONSOLE_DEV_USB_SERIAL_JTAG_CONFIG_DEFAULT();
+    ESP_ERROR_CHECK(esp_console_new_repl_usb_serial_jtag(&hw_config, &repl_config, &repl));
+#else
+#error "Benchmark-Konsole benötigt UART oder USB-Serial-JTAG als Konsole"
+#endif
+
+    esp_console_register_help_command();
+    register_bench_command();
+#if CONFIG_BENCH_TRACE
+    register_trace_command();
+#endif
+#if CONFIG_BENCH_RESULT_LOG
+    register_log_command();
+#endif
+    ESP_ERROR_CHECK(esp_console_start_repl(repl));
+#endif
+}
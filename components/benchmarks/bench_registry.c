@@ -0,0 +1,269 @@
+#include "bench_registry.h"
+#include "bench_stats.h"
+#include "result_sink.h"
+#include "result_log.h"
+#include "pmu.h"
+#include "trace.h"
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+
+// ============ ZUSTAND ============
+static bench_def_t* s_head;
+static uint32_t s_sample_arena[CONFIG_BENCH_STATS_MAX_SAMPLES];
+static volatile bool s_pmu_active;
+
+// ============ REGISTRY ============
+/**
+ * @brief Fügt einen Benchmark sortiert nach Suite und Name ein
+ * Die Reihenfolge der Konstruktoren ist nicht festgelegt, die Liste schon.
+ * @param def Benchmark-Definition (statisch, bleibt gültig)
+ */
+void bench_register(bench_def_t* def) {
+    bench_def_t** link = &s_head;
+    while (*link != NULL) {
+        int order = strcmp((*link)->suite, def->suite);
+        if (order > 0 || (order == 0 && strcmp((*link)->name, def->name) > 0)) {
+            break;
+        }
+        link = &(*link)->next;
+    }
+    def->next = *link;
+    *link = def;
+}
+
+/**
+ * @brief Erster registrierter Benchmark (Liste über def->next)
+ */
+bench_def_t* bench_first(void) {
+    return s_head;
+}
+
+/**
+ * @brief Glob-Vergleich mit '*' und '?' auf einem Teilstring
+ * @param pattern Muster (endet bei end)
+ * @param end Ende des Musters
+ * @param text Nullterminierter Text
+ * @param text_end Ende des Textes
+ */
+static bool glob_match(const char* pattern, const char* end, const char* text, const char* text_end) {
+    while (pattern < end) {
+        if (*pattern == '*') {
+            for (const char* t = text; t <= text_end; t++) {
+                if (glob_match(pattern + 1, end, t, text_end)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        if (text == text_end || (*pattern != '?' && *pattern != *text)) {
+            return false;
+        }
+        pattern++;
+        text++;
+    }
+    return text == text_end;
+}
+
+/**
+ * @brief Prüft ein Muster gegen alle Tags eines Benchmarks
+ */
+static bool tags_match(const char* tags, const char* pattern, const char* end) {
+    while (tags != NULL && *tags != '\0') {
+        const char* tag_end = strchr(tags, ',');
+        if (tag_end == NULL) {
+            tag_end = tags + strlen(tags);
+        }
+        if (glob_match(pattern, end, tags, tag_end)) {
+            return true;
+        }
+        tags = *tag_end ? tag_end + 1 : tag_end;
+    }
+    return false;
+}
+
+/**
+ * @brief Prüft, ob ein Benchmark zum Filter passt
+ * Filter: Komma-getrennte Globs, ein Treffer auf Name, Suite oder Tag genügt.
+ * @param def Benchmark
+ * @param filter Filter (NULL oder "" = alle)
+ */
+bool bench_matches(const bench_def_t* def, const char* filter) {
+    if (filter == NULL || *filter == '\0') {
+        return true;
+    }
+    while (*filter != '\0') {
+        const char* end = strchr(filter, ',');
+        if (end == NULL) {
+            end = filter + strlen(filter);
+        }
+        if (end > filter &&
+            (glob_match(filter, end, def->name, def->name + strlen(def->name)) ||
+             glob_match(filter, end, def->suite, def->suite + strlen(def->suite)) ||
+             tags_match(def->tags, filter, end))) {
+            return true;
+        }
+        filter = *end ? end + 1 : end;
+    }
+    return false;
+}
+
+// ============ RUNNER ============
+typedef struct {
+    bench_def_t* def;
+    uint32_t iterations;
+} sample_ctx_t;
+
+/**
+ * @brief Ein Benchmark-Durchlauf als Sample: Datensatz in den Ringpuffer, Zyklen an die Statistik
+ */
+static uint32_t sample_bench(void* arg) {
+    const sample_ctx_t* ctx = arg;
+    uint32_t result = 0;
+    TRACE_BEGIN("bench.sample");
+    uint32_t cycles = ctx->def->fn(ctx->def->arg, ctx->iterations, &result);
+    TRACE_END("bench.sample");
+    result_sink_push(ctx->def->test_id, ctx->iterations, cycles, result);
+    return cycles;
+}
+
+/**
+ * @brief Ein Benchmark-Durchlauf als PMU-Last (ohne Datensatz)
+ */
+static void pmu_sample(void* arg) {
+    const sample_ctx_t* ctx = arg;
+    uint32_t result = 0;
+    ctx->def->fn(ctx->def->arg, ctx->iterations, &result);
+}
+
+/**
+ * @brief Läuft fn gerade als PMU-Last?
+ * @return true während run_pmu(); Zyklen und Ergebnis sind dann keine Zeitmessung
+ */
+bool bench_pmu_active(void) {
+    return s_pmu_active;
+}
+
+/**
+ * @brief Standardauswahl aus der Kconfig
+ */
+void bench_run_spec_default(bench_run_spec_t* spec) {
+    spec->filter = CONFIG_BENCH_DEFAULT_FILTER;
+    spec->repeat = CONFIG_BENCH_DEFAULT_REPEAT;
+    spec->iterations = CONFIG_BENCH_DEFAULT_ITERATIONS;
+    spec->pmu_events = pmu_parse_events(CONFIG_BENCH_PMU_DEFAULT_EVENTS);
+}
+
+/**
+ * @brief Zählt PMU-Ereignisse eines Benchmarks und gibt sie aus
+ * Läuft nach der Zeitmessung in eigenen Durchläufen, weil das PMU des
+ * ESP32-C6 sich den Zähler mit get_cycle_count() teilt. Gezählt wird der
+ * ganze Aufruf inklusive Setup des Benchmarks.
+ */
+static void run_pmu(const sample_ctx_t* ctx, uint32_t events) {
+    pmu_result_t pmu;
+
+    TRACE_BEGIN("bench.pmu");
+    s_pmu_active = true;
+    pmu_measure(events, CONFIG_BENCH_PMU_REPS, pmu_sample, (void*)ctx, &pmu);
+    s_pmu_active = false;
+    TRACE_END("bench.pmu");
+
+    for (int ev = 0; ev < PMU_EV_COUNT; ev++) {
+        if (pmu.events & PMU_EVENT_BIT(ev)) {
+            result_pmu_record_t rec = {
+                ctx->def->test_id, (uint8_t)ev, pmu.reps[ev], ctx->iterations, pmu.counts[ev]
+            };
+            result_sink_emit_pmu(&rec);
+        }
+    }
+    pmu_print(ctx->def->name, ctx->iterations, &pmu);
+}
+
+/**
+ * @brief Misst einen Benchmark adaptiv und gibt die Zusammenfassung aus
+ * @param def Benchmark
+ * @param iterations Angeforderte Iterationen (0 = Standard)
+ * @param pmu_events Zusätzliche PMU-Ereignisse
+ * @param cfg Abbruchkriterien
+ */
+static void run_one(bench_def_t* def, uint32_t iterations, uint32_t pmu_events, const bench_adaptive_cfg_t* cfg) {
+    bench_stats_t stats;
+    bench_summary_t summary;
+    sample_ctx_t ctx = { def, iterations ? iterations : def->iterations };
+
+    // Auf ganze Granulen abrunden, mindestens eine (Division pro Operation)
+    uint32_t granule = def->granularity > 1 ? def->granularity : 1;
+    ctx.iterations -= ctx.iterations % granule;
+    if (ctx.iterations == 0) {
+        ctx.iterations = granule;
+    }
+    if (def->test_id == BENCH_TEST_ID_NONE) {
+        def->test_id = result_sink_register_test(def->name);
+    }
+
+    TRACE_BEGIN_DYN(def->name, def->test_id);
+    bench_stats_init(&stats, s_sample_arena, CONFIG_BENCH_STATS_MAX_SAMPLES);
+    bench_stats_run_adaptive(&stats, cfg, sample_bench, &ctx, &summary);
+
+    // Ausgabe erst nach dem Messfenster
+    TRACE_BEGIN("bench.output");
+    result_sink_flush();
+    bench_stats_print(def->name, &summary);
+    printf("%s: %.3f Zyklen pro Operation (Median)\n", def->name, summary.median / ctx.iterations);
+    TRACE_END("bench.output");
+
+    pmu_events |= def->pmu_events;
+    if (pmu_events != 0 && pmu_available()) {
+        run_pmu(&ctx, pmu_events);
+    }
+
+    // Ergebnislog erst nach Messung und Ausgabe in den Flash schreiben
+    result_log_commit();
+    TRACE_END_DYN(def->name, def->test_id);
+}
+
+/**
+ * @brief Führt alle passenden Benchmarks aus
+ * @param spec Filter, Wiederholungen und Iterationen
+ * @return Anzahl ausgeführter Messungen
+ */
+size_t bench_run(const bench_run_spec_t* spec) {
+    bench_adaptive_cfg_t cfg;
+    bench_adaptive_cfg_default(&cfg);
+    size_t count = 0;
+    uint32_t repeat = spec->repeat ? spec->repeat : 1;
+
+    printf("\n=== BENCHMARK-LAUF (Filter \"%s\", %" PRIu32 "x, Ziel-KI %.1f%%, Budget %" PRIu64 " ms) ===\n",
+           spec->filter ? spec->filter : "", repeat, cfg.target_ci_rel * 100.0, cfg.time_budget_us / 1000);
+
+    for (uint32_t r = 0; r < repeat; r++) {
+        for (bench_def_t* def = s_head; def != NULL; def = def->next) {
+            if (bench_matches(def, spec->filter)) {
+                run_one(def, spec->iterations, spec->pmu_events, &cfg);
+                count++;
+            }
+        }
+    }
+    if (count == 0) {
+        printf("Keine Benchmarks passend zu \"%s\"\n", spec->filter ? spec->filter : "");
+    }
+    return count;
+}
+
+/**
+ * @brief Listet alle passenden Benchmarks
+ * @param filter Filter (NULL oder "" = alle)
+ * @return Anzahl gelisteter Benchmarks
+ */
+size_t bench_list(const char* filter) {
+    size_t count = 0;
+    for (const bench_def_t* def = s_head; def != NULL; def = def->next) {
+        if (bench_matches(def, filter)) {
+            printf("%-10s %-24s %8" PRIu32 "  %s\n", def->suite, def->name, def->iterations, def->tags);
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,88 @@
+#ifndef BENCH_REGISTRY_H
+#define BENCH_REGISTRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Benchmark-Signatur: misst iterations Operationen, liefert bereinigte Zyklen,
+// Ergebniswert (Verifikation) über result
+typedef uint32_t (*bench_fn_t)(void* arg, uint32_t iterations, uint32_t* result);
+
+#define BENCH_TEST_ID_NONE  0xFFFE      // Noch nicht angemeldet (≠ RESULT_SINK_INVALID_ID)
+
+typedef struct bench_def {
+    const char* name;           // Eindeutiger Testname, z. B. "mulh.lat"
+    const char* suite;          // micro, memory, interrupt, power
+    const char* tags;           // Komma-getrennt, z. B. "muldiv,latency"
+    uint32_t iterations;        // Standard-Operationen pro Sample
+    uint32_t granularity;       // Iterationen werden auf Vielfache gerundet (z. B. Unroll-Faktor)
+    bench_fn_t fn;
+    void* arg;
+    uint32_t pmu_events;        // PMU-Ereignisse (PMU_EVENT_BIT) nach der Zeitmessung, 0 = keine
+    uint16_t test_id;           // Vom Runner beim Result-Sink angemeldet
+    struct bench_def* next;
+} bench_def_t;
+
+/**
+ * @brief Registriert einen Benchmark vor app_main() (Konstruktor-Tabelle)
+ * Die Komponente wird mit WHOLE_ARCHIVE gelinkt, damit Objekte, die nur
+ * Registrierungen enthalten, nicht vom Linker verworfen werden.
+ */
+#define BENCH_REGISTER(ident, name, suite, tags, iterations, granularity, fn, arg) \
+    BENCH_REGISTER_PMU(ident, name, suite, tags, iterations, granularity, fn, arg, 0)
+
+/**
+ * @brief Wie BENCH_REGISTER, zusätzlich mit PMU-Ereignissen (z. B. PMU_SET_STALLS)
+ */
+#define BENCH_REGISTER_PMU(ident, name, suite, tags, iterations, granularity, fn, arg, pmu_events) \
+    static bench_def_t s_bench_def_##ident = { \
+        name, suite, tags, iterations, granularity, fn, arg, pmu_events, BENCH_TEST_ID_NONE, NULL \
+    }; \
+    __attribute__((constructor)) static void bench_register_##ident(void) { \
+        bench_register(&s_bench_def_##ident); \
+    }
+
+// Auswahl für einen Lauf
+typedef struct {
+    const char* filter;         // Komma-getrennte Globs auf Name, Suite oder Tag; NULL/"" = alle
+    uint32_t repeat;            // Durchläufe über die Auswahl
+    uint32_t iterations;        // 0 = Standard des Benchmarks
+    uint32_t pmu_events;        // Zusätzliche PMU-Ereignisse für alle Benchmarks
+} bench_run_spec_t;
+
+// Registry
+void bench_register(bench_def_t* def);
+bench_def_t* bench_first(void);
+bool bench_matches(const bench_def_t* def, const char* filter);
+
+// Runner
+void bench_run_spec_default(bench_run_spec_t* spec);
+size_t bench_run(const bench_run_spec_t* spec);
+size_t bench_list(const char* filter);
+
+// PMU-Läufe wiederholen fn, während der Zykluszähler Ereignisse zählt:
+// Benchmarks mit eigener Buchführung (Minima für Tabellen) überspringen sie dann
+bool bench_pmu_active(void);
+
+/**
+ * @brief Führt ein Minimum aus Zeitmessungen nach, nicht in PMU-Läufen
+ */
+static inline void bench_track_min(float* best, float value) {
+    if (!bench_pmu_active() && value < *best) {
+        *best = value;
+    }
+}
+
+// Konsole (Befehl "bench")
+void bench_console_start(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,336 @@
+#include "bench_stats.h"
+#include "measurement_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+
+// ============ KONFIGURATION ============
+#define CHECK_INTERVAL      8       // Abbruchkriterium alle N Samples prüfen (sortiert die Arena)
+#define MAD_TO_SIGMA        1.4826  // MAD -> Standardabweichung bei Normalverteilung
+
+// Zweiseitige 95%-Quantile der t-Verteilung für 1..30 Freiheitsgrade
+static const double s_t95[30] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+};
+
+static double t95(uint32_t dof) {
+    if (dof == 0) {
+        return INFINITY;
+    }
+    return dof <= 30 ? s_t95[dof - 1] : 1.96;
+}
+
+// ============ P²-QUANTILSCHÄTZER ============
+/**
+ * @brief Initialisiert einen P²-Schätzer
+ * @param est Schätzer
+ * @param p Gesuchtes Quantil (z. B. 0.5 für den Median)
+ */
+void p2_init(p2_quantile_t* est, double p) {
+    est->p = p;
+    est->count = 0;
+    est->step[0] = 0.0;
+    est->step[1] = p / 2.0;
+    est->step[2] = p;
+    est->step[3] = (1.0 + p) / 2.0;
+    est->step[4] = 1.0;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Parabolische Vorhersage der Markerhöhe (P²-Formel)
+ */
+static double p2_parabolic(const p2_quantile_t* est, int i, double d) {
+    const double* q = est->q;
+    const double* n = est->pos;
+    return q[i] + d / (n[i + 1] - n[i - 1]) *
+           ((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+            (n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+}
+
+/**
+ * @brief Fügt einen Wert zum P²-Schätzer hinzu
+ */
+void p2_add(p2_quantile_t* est, double x) {
+    if (est->count < 5) {
+        est->q[est->count++] = x;
+        if (est->count == 5) {
+            qsort(est->q, 5, sizeof(double), compare_double);
+            for (int i = 0; i < 5; i++) {
+                est->pos[i] = i + 1;
+            }
+            est->want[0] = 1.0;
+            est->want[1] = 1.0 + 2.0 * est->p;
+            est->want[2] = 1.0 + 4.0 * est->p;
+            est->want[3] = 3.0 + 2.0 * est->p;
+            est->want[4] = 5.0;
+        }
+        return;
+    }
+
+    // Zelle bestimmen, Extremwerte nachziehen
+    int k;
+    if (x < est->q[0]) {
+        est->q[0] = x;
+        k = 0;
+    } else if (x >= est->q[4]) {
+        est->q[4] = x;
+        k = 3;
+    } else {
+        k = 0;
+        while (x >= est->q[k + 1]) {
+            k++;
+        }
+    }
+
+    for (int i = k + 1; i < 5; i++) {
+        est->pos[i] += 1.0;
+    }
+    for (int i = 0; i < 5; i++) {
+        est->want[i] += est->step[i];
+    }
+
+    // Innere Marker nachjustieren
+    for (int i = 1; i <= 3; i++) {
+        double d = est->want[i] - est->pos[i];
+        if ((d >= 1.0 && est->pos[i + 1] - est->pos[i] > 1.0) ||
+            (d <= -1.0 && est->pos[i - 1] - est->pos[i] < -1.0)) {
+            double ds = d > 0 ? 1.0 : -1.0;
+            double qp = p2_parabolic(est, i, ds);
+            if (est->q[i - 1] < qp && qp < est->q[i + 1]) {
+                est->q[i] = qp;
+            } else {
+                int j = i + (int)ds;
+                est->q[i] += ds * (est->q[j] - est->q[i]) / (est->pos[j] - est->pos[i]);
+            }
+            est->pos[i] += ds;
+        }
+    }
+    est->count++;
+}
+
+/**
+ * @brief Aktuelle Quantilschätzung
+ * Unter fünf Werten wird exakt aus den gespeicherten Werten bestimmt.
+ */
+double p2_get(const p2_quantile_t* est) {
+    if (est->count == 0) {
+        return 0.0;
+    }
+    if (est->count < 5) {
+        double sorted[5];
+        for (uint32_t i = 0; i < est->count; i++) {
+            sorted[i] = est->q[i];
+        }
+        qsort(sorted, est->count, sizeof(double), compare_double);
+        uint32_t idx = (uint32_t)lround(est->p * (est->count - 1));
+        return sorted[idx];
+    }
+    return est->q[2];
+}
+
+// ============ STREAMING-STATISTIK ============
+/**
+ * @brief Initialisiert die Statistik über einer festen Sample-Arena
+ * @param stats Statistik
+ * @param arena Speicher für Einzelsamples (für die MAD-Filterung)
+ * @param capacity Anzahl der Arena-Plätze
+ */
+void bench_stats_init(bench_stats_t* stats, uint32_t* arena, uint32_t capacity) {
+    stats->arena = arena;
+    stats->capacity = capacity;
+    stats->stored = 0;
+    stats->count = 0;
+    stats->mean = 0.0;
+    stats->m2 = 0.0;
+    stats->min = UINT32_MAX;
+    stats->max = 0;
+    p2_init(&stats->median, 0.5);
+    p2_init(&stats->p99, 0.99);
+}
+
+/**
+ * @brief Nimmt ein Sample auf (Welford, Min/Max, Quantile, Arena)
+ * Ist die Arena voll, fließt das Sample nur noch in die Streaming-Werte ein.
+ */
+void bench_stats_add(bench_stats_t* stats, uint32_t sample) {
+    stats->count++;
+    double delta = sample - stats->mean;
+    stats->mean += delta / stats->count;
+    stats->m2 += delta * (sample - stats->mean);
+
+    if (sample < stats->min) {
+        stats->min = sample;
+    }
+    if (sample > stats->max) {
+        stats->max = sample;
+    }
+    p2_add(&stats->median, sample);
+    p2_add(&stats->p99, sample);
+
+    if (stats->stored < stats->capacity) {
+        stats->arena[stats->stored++] = sample;
+    }
+}
+
+static int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Median einer sortierten Folge
+ */
+static double sorted_median(const uint32_t* v, uint32_t n) {
+    return (n % 2) ? v[n / 2] : ((double)v[n / 2 - 1] + v[n / 2]) / 2.0;
+}
+
+/**
+ * @brief Median der absoluten Abweichungen vom Median (MAD)
+ * Nutzt die Sortierung: links und rechts des Medians wachsen die Abweichungen
+ * monoton, daher genügt ein Merge beider Seiten ohne Zusatzspeicher.
+ */
+static double sorted_mad(const uint32_t* v, uint32_t n, double median) {
+    int32_t left = (int32_t)(n / 2) - 1;
+    uint32_t right = n / 2;
+    double prev = 0.0;
+    double cur = 0.0;
+
+    for (uint32_t k = 0; k <= n / 2; k++) {
+        double dl = left >= 0 ? median - v[left] : INFINITY;
+        double dr = right < n ? v[right] - median : INFINITY;
+        prev = cur;
+        if (dl < dr) {
+            cur = dl;
+            left--;
+        } else {
+            cur = dr;
+            right++;
+        }
+    }
+    return (n % 2) ? cur : (prev + cur) / 2.0;
+}
+
+/**
+ * @brief Fasst die Statistik zusammen und verwirft Ausreißer per MAD
+ * Mittelwert/Streuung, Min/Max und Median/p99 stammen aus den Streaming-Werten
+ * über alle Samples. Die MAD-Filterung und das Konfidenzintervall beziehen
+ * sich auf die Arena, also nur auf die ersten capacity Samples; sie landen
+ * getrennt in filtered_*. Sortiert die Arena in place.
+ * @param stats Statistik
+ * @param mad_threshold Schwelle k in Einheiten von 1.4826 * MAD
+ * @param out Zusammenfassung
+ */
+void bench_stats_summarize(bench_stats_t* stats, double mad_threshold, bench_summary_t* out) {
+    uint32_t n = stats->stored;
+
+    out->samples = stats->count;
+    out->mean = stats->mean;
+    out->stddev = stats->count > 1 ? sqrt(stats->m2 / (stats->count - 1)) : 0.0;
+    out->min = stats->count ? stats->min : 0;
+    out->max = stats->max;
+    out->median = p2_get(&stats->median);
+    out->p99 = p2_get(&stats->p99);
+    out->filtered = 0;
+    out->rejected = 0;
+    out->filtered_mean = 0.0;
+    out->filtered_stddev = 0.0;
+    out->ci_rel = INFINITY;
+    if (n == 0) {
+        return;
+    }
+
+    qsort(stats->arena, n, sizeof(uint32_t), compare_u32);
+    double median = sorted_median(stats->arena, n);
+    double scale = MAD_TO_SIGMA * sorted_mad(stats->arena, n, median);
+    double limit = mad_threshold * (scale < 1.0 ? 1.0 : scale);   // quantisierte Zyklen: MAD kann 0 sein
+
+    uint32_t valid = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        double x = stats->arena[i];
+        if (fabs(x - median) > limit) {
+            out->rejected++;
+            continue;
+        }
+        valid++;
+        double delta = x - mean;
+        mean += delta / valid;
+        m2 += delta * (x - mean);
+    }
+
+    out->filtered = valid;
+    out->filtered_mean = mean;
+    out->filtered_stddev = valid > 1 ? sqrt(m2 / (valid - 1)) : 0.0;
+    if (valid > 1 && mean > 0.0) {
+        out->ci_rel = t95(valid - 1) * out->filtered_stddev / sqrt((double)valid) / mean;
+    }
+}
+
+// ============ ADAPTIVE WIEDERHOLUNG ============
+/**
+ * @brief Standardwerte aus der Kconfig
+ */
+void bench_adaptive_cfg_default(bench_adaptive_cfg_t* cfg) {
+    cfg->min_samples = CONFIG_BENCH_STATS_MIN_SAMPLES;
+    cfg->max_samples = CONFIG_BENCH_STATS_MAX_SAMPLES;
+    cfg->target_ci_rel = CONFIG_BENCH_STATS_TARGET_CI_PERMILLE / 1000.0;
+    cfg->time_budget_us = (uint64_t)CONFIG_BENCH_STATS_TIME_BUDGET_MS * 1000;
+    cfg->mad_threshold = CONFIG_BENCH_STATS_MAD_THRESHOLD_X10 / 10.0;
+}
+
+/**
+ * @brief Wiederholt eine Messung, bis das Konfidenzintervall klein genug ist
+ * Abbruch, sobald die relative KI-Halbbreite unter target_ci_rel fällt, das
+ * Zeitbudget verbraucht ist oder max_samples (bzw. die Arena) erreicht ist.
+ * Das Zeitbudget gilt in jeder Runde, auch vor min_samples.
+ * @param stats Initialisierte Statistik
+ * @param cfg Abbruchkriterien
+ * @param sample Liefert je Aufruf ein Sample
+ * @param ctx Kontext für sample
+ * @param out Zusammenfassung
+ */
+void bench_stats_run_adaptive(bench_stats_t* stats, const bench_adaptive_cfg_t* cfg,
+                              bench_sample_fn sample, void* ctx, bench_summary_t* out) {
+    uint32_t max_samples = cfg->max_samples < stats->capacity ? cfg->max_samples : stats->capacity;
+    uint64_t start_us = get_time_us();
+
+    while (stats->count < max_samples) {
+        bench_stats_add(stats, sample(ctx));
+
+        if (get_time_us() - start_us >= cfg->time_budget_us) {
+            break;
+        }
+        if (stats->count < cfg->min_samples || (stats->count % CHECK_INTERVAL) != 0) {
+            continue;
+        }
+        bench_stats_summarize(stats, cfg->mad_threshold, out);
+        if (out->ci_rel <= cfg->target_ci_rel) {
+            return;
+        }
+    }
+    bench_stats_summarize(stats, cfg->mad_threshold, out);
+}
+
+// ============ AUSGABE ============
+/**
+ * @brief Gibt eine Zusammenfassung als Textzeile aus (außerhalb des Messpfads)
+ */
+void bench_stats_print(const char* test_name, const bench_summary_t* summary) {
+    printf("%s: n=%" PRIu32 " mean=%.1f sd=%.1f min=%" PRIu32 " median=%.1f p99=%.1f max=%" PRIu32
+           " | gefiltert n=%" PRIu32 " (-%" PRIu32 " Ausreisser) mean=%.1f sd=%.1f ci=%.2f%% Zyklen\n",
+           test_name, summary->samples, summary->mean, summary->stddev, summary->min,
+           summary->median, summary->p99, summary->max, summary->filtered, summary->rejected,
+           summary->filtered_mean, summary->filtered_stddev, summary->ci_rel * 100.0);
+}
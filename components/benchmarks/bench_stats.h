@@ -0,0 +1,77 @@
+#ifndef BENCH_STATS_H
+#define BENCH_STATS_H
+
+#include <stdint.h>
+
+// P²-Quantilschätzer (Jain/Chlamtac): fünf Marker, konstanter Speicher
+typedef struct {
+    double p;           // Gesuchtes Quantil (0..1)
+    double q[5];        // Markerhöhen
+    double pos[5];      // Ist-Positionen der Marker
+    double want[5];     // Soll-Positionen der Marker
+    double step[5];     // Zuwachs der Soll-Positionen pro Sample
+    uint32_t count;
+} p2_quantile_t;
+
+// Streaming-Statistik mit fester Sample-Arena
+typedef struct {
+    uint32_t* arena;        // Vom Aufrufer bereitgestellter Speicher
+    uint32_t capacity;      // Größe der Arena in Samples
+    uint32_t stored;        // Belegte Arena-Plätze
+    uint32_t count;         // Alle gesehenen Samples
+    double mean;            // Welford
+    double m2;              // Welford: Summe der Abweichungsquadrate
+    uint32_t min;
+    uint32_t max;
+    p2_quantile_t median;
+    p2_quantile_t p99;
+} bench_stats_t;
+
+// Zusammenfassung: Streaming-Werte über alle Samples, dazu die MAD-gefilterten
+// Werte über die Arena (nur die ersten capacity Samples)
+typedef struct {
+    uint32_t samples;       // Alle Samples
+    double mean;            // Welford über alle Samples
+    double stddev;          // Welford über alle Samples
+    uint32_t filtered;      // Gültige Arena-Samples nach der MAD-Filterung
+    uint32_t rejected;      // Als Ausreißer verworfene Arena-Samples
+    double filtered_mean;   // Mittelwert der gültigen Arena-Samples
+    double filtered_stddev; // Standardabweichung der gültigen Arena-Samples
+    double ci_rel;          // Relative Halbbreite des 95%-KI um filtered_mean
+    uint32_t min;
+    uint32_t max;
+    double median;          // P²-Schätzung über alle Samples
+    double p99;             // P²-Schätzung über alle Samples
+} bench_summary_t;
+
+// Abbruchkriterien der adaptiven Wiederholung
+typedef struct {
+    uint32_t min_samples;
+    uint32_t max_samples;       // Zusätzlich durch die Arena begrenzt
+    double target_ci_rel;       // z. B. 0.01 = ±1 % um den Mittelwert
+    uint64_t time_budget_us;
+    double mad_threshold;       // Ausreißer ab |x - Median| > k * 1.4826 * MAD
+} bench_adaptive_cfg_t;
+
+// Liefert ein Sample (z. B. bereinigte Zyklen eines Kernel-Durchlaufs)
+typedef uint32_t (*bench_sample_fn)(void* ctx);
+
+// Quantilschätzer
+void p2_init(p2_quantile_t* est, double p);
+void p2_add(p2_quantile_t* est, double x);
+double p2_get(const p2_quantile_t* est);
+
+// Streaming-Statistik
+void bench_stats_init(bench_stats_t* stats, uint32_t* arena, uint32_t capacity);
+void bench_stats_add(bench_stats_t* stats, uint32_t sample);
+void bench_stats_summarize(bench_stats_t* stats, double mad_threshold, bench_summary_t* out);
+
+// Adaptive Wiederholung
+void bench_adaptive_cfg_default(bench_adaptive_cfg_t* cfg);
+void bench_stats_run_adaptive(bench_stats_t* stats, const bench_adaptive_cfg_t* cfg,
+                              bench_sample_fn sample, void* ctx, bench_summary_t* out);
+
+// Ausgabe
+void bench_stats_print(const char* test_name, const bench_summary_t* summary);
+
+#endif
@@ -1,6 +1,46 @@
 #include "benchmarks.h"
+#include "bench_registry.h"
+#include "mem_bench.h"
+#include "place_bench.h"
+#include "hazard_bench.h"
+#include "app_bench.h"
 #include "measurement_utils.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/**
+ * @brief Führt eine Suite mit den Standard-Iterationen einmal aus
+ */
+static void run_suite(const char* suite) {
+    bench_run_spec_t spec = { .filter = suite, .repeat = 1, .iterations = 0 };
+    bench_run(&spec);
+}
+
+void run_micro_benchmarks(void) {
+    run_suite("micro");
+    place_bench_print_table();
+    hazard_bench_print_table();
+}
+
+void run_interrupt_benchmarks(void) {
+    run_suite("interrupt");
+}
+
+void run_power_benchmarks(void) {
+    run_suite("power");
+}
+
+void run_memory_benchmarks(void) {
+    run_suite("memory");
+    mem_bench_print_curves();
+}
+
+void run_app_benchmarks(void) {
+    app_bench_verify();
+    run_suite("app");
+    app_bench_print_table();
+}
 
 void print_main_menu(void) {
     printf("\n BENCHMARK MENU:\n");
@@ -10,6 +50,7 @@ void print_main_menu(void) {
     printf("4 - Memory Access Benchmarks\n");
     printf("5 - Run ALL Benchmarks\n");
     printf("6 - Custom Experiment\n");
+    printf("7 - Application Kernels (CRC, DSP, Crypto)\n");
     printf("0 - System Info\n");
     printf("🎮 Choice: ");
 }
@@ -20,6 +61,65 @@ void run_all_benchmarks(void) {
     run_interrupt_benchmarks();
     run_power_benchmarks();
     run_memory_benchmarks();
+    run_app_benchmarks();
     printf(" ALL BENCHMARKS COMPLETED!\n");
 }
 
+/**
+ * @brief Liest eine Menüauswahl von stdin
+ * @return Gewählte Nummer oder -1 bei ungültiger Eingabe
+ */
+int get_user_choice(void) {
+    char line[16];
+    if (fgets(line, sizeof(line), stdin) == NULL) {
+        return -1;
+    }
+    char* end = NULL;
+    long choice = strtol(line, &end, 10);
+    return end == line ? -1 : (int)choice;
+}
+
+/**
+ * @brief Führt einen Menüpunkt aus
+ * @param choice Nummer aus print_main_menu()
+ */
+void execute_benchmark(int choice) {
+    switch (choice) {
+    case 1:
+        run_micro_benchmarks();
+        break;
+    case 2:
+        run_interrupt_benchmarks();
+        break;
+    case 3:
+        run_power_benchmarks();
+        break;
+    case 4:
+        run_memory_benchmarks();
+        break;
+    case 5:
+        run_all_benchmarks();
+        break;
+    case 6: {
+        // Eigenes Experiment: Auswahl aus der Kconfig (Filter/Wiederholungen/Iterationen)
+        bench_run_spec_t spec;
+        bench_run_spec_default(&spec);
+        bench_run(&spec);
+        break;
+    }
+    case 7:
+        run_app_benchmarks();
+        break;
+    case 0: {
+        const timing_calibration_t* cal = timing_get_calibration();
+        printf("CPU: %" PRIu32 " MHz, Messklammer %" PRIu32 " Zyklen\n",
+               cal->cpu_freq_mhz, cal->bracket_cycles);
+        printf("Registrierte Benchmarks:\n");
+        bench_list(NULL);
+        break;
+    }
+    default:
+        printf("Ungültige Auswahl: %d\n", choice);
+        break;
+    }
+}
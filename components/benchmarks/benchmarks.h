@@ -8,6 +8,7 @@ void run_micro_benchmarks(void);
 void run_interrupt_benchmarks(void);
 void run_power_benchmarks(void);
 void run_memory_benchmarks(void);
+void run_app_benchmarks(void);
 void run_all_benchmarks(void);
 
 // Hilfsfunktionen
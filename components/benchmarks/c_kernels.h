@@ -0,0 +1,31 @@
+#ifndef C_KERNELS_H
+#define C_KERNELS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// C-Referenzkernel, Gegenstück zu den gleichnamigen Assembler-Kerneln.
+// c_kernels.inc wird pro Optimierungsstufe einmal übersetzt (CMakeLists.txt),
+// Symbole: ck_<variante>_<ident>, Testnamen: cref.<name>.<variante>
+#define C_KERNEL_LIST(X, variant) \
+    /* ident     name        ops/schleife */ \
+    X(variant,   add_lat,    "add.lat",  1) \
+    X(variant,   add_thr,    "add.thr",  4) \
+    X(variant,   mul_lat,    "mul.lat",  1) \
+    X(variant,   lw_lat,     "lw.lat",   1)
+
+#define C_KERNEL_DECLARE(variant, ident, name, ops) \
+    uint32_t ck_##variant##_##ident(void* arg, uint32_t iterations, uint32_t* result);
+
+// Die O2-Variante dient als Warm-up (app_main.c). Der Standard-Build nutzt
+// -Og (CONFIG_COMPILER_OPTIMIZATION_DEBUG), das entspricht der Og-Variante.
+C_KERNEL_LIST(C_KERNEL_DECLARE, O2)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
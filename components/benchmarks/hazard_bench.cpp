@@ -0,0 +1,394 @@
+// Pipeline-Hazards: Sprungmuster, Load-Use-Abstand, DIV/REM nach
+// Operandengröße und Store-to-Load-Forwarding
+//
+// Jeder Fall misst zwei Kernel mit identischer Instruktionsfolge:
+//   Basis - das Ereignis ist entschärft (nop statt Sprung, Verbraucher liest
+//           ein anderes Register, add statt div, Load auf andere Adresse)
+//   Test  - das Ereignis tritt in jeder Ausrollstufe einmal auf
+// Gemeldet werden die Zyklen des Tests abzüglich der Basis, die
+// Schleifensteuerung fällt dabei heraus. Die Tabelle zieht das Minimum der
+// Basis vom Minimum des Tests ab (robuster als das Minimum der Differenzen).
+
+#include "hazard_bench.h"
+#include "bench_registry.h"
+#include "measurement_utils.h"
+#include <stdio.h>
+#include <string.h>
+#include <float.h>
+#include "sdkconfig.h"
+
+#if defined(__riscv)
+
+// ============ KONFIGURATION ============
+#define HAZARD_EVENTS           1024    // Ereignisse pro Aufruf
+#define HAZARD_UNROLL           8       // Ereignisse pro Schleifendurchlauf (außer Sprünge)
+#define BRANCH_TABLE_LEN        256     // Zweierpotenz, Index läuft über andi
+#define STLF_ALIAS_OFFSET       64      // Basis: Load auf ein anderes Wort
+
+struct hazard_case_t {
+    const char* group;
+    const char* variant;
+    uint32_t a;                 // Sprünge: Muster, DIV: Dividend
+    uint32_t b;                 // DIV: Divisor
+    float test;                 // Minimum Zyklen pro Ereignis
+    float base;
+};
+
+typedef uint32_t (*hazard_kernel_fn)(const hazard_case_t* c, uint32_t loops, uint32_t* result);
+
+// ============ FÄLLE ============
+// Sprungmuster (1 = genommen), siehe init_branch_patterns()
+#define BRANCH_PATTERNS(X) \
+    X(never) X(always) X(alt) X(loop4) X(loop16) X(nested) X(rand50) X(rand90) X(custom)
+
+#define LOADUSE_DISTS(X) \
+    X(0) X(1) X(2) X(3) X(4)
+
+#define DIV_OPS(X) \
+    X(div) X(divu) X(rem) X(remu)
+// Dividend wächst in signifikanten Bits, Divisor 3; big = kleiner Quotient,
+// zero = Division durch null (definiert, kein Trap), neg = negativer Dividend
+#define DIV_MAGS(X, op) \
+    X(op, b1, 0x00000001, 3) \
+    X(op, b8, 0x000000B5, 3) \
+    X(op, b16, 0x0000B5A5, 3) \
+    X(op, b24, 0x00B5A5A5, 3) \
+    X(op, b31, 0x75A5A5A5, 3) \
+    X(op, big, 0x75A5A5A5, 0x03A5A5A5) \
+    X(op, zero, 0x75A5A5A5, 0) \
+    X(op, neg, 0x8A5A5A5B, 3)
+
+// Store und abhängiger Load über dieselbe Adresse (%[off] = 0 im Test)
+#define STLF_CASES(X) \
+    X(sw_lw,      "sw.lw",      "sw t0, 0(a4)\n",                                   "lw t0, %[off](a4)\n") \
+    X(sh_lw,      "sh.lw",      "sh t0, 0(a4)\n",                                   "lw t0, %[off](a4)\n") \
+    X(sb_lbu,     "sb.lbu",     "sb t0, 1(a4)\n",                                   "lbu t0, %[off]+1(a4)\n") \
+    X(sw_lhu,     "sw.lhu",     "sw t0, 0(a4)\n",                                   "lhu t0, %[off]+2(a4)\n") \
+    X(sw_gap2_lw, "sw.gap2.lw", "sw t0, 0(a4)\n addi t1, t1, 1\n addi t2, t2, 1\n", "lw t0, %[off](a4)\n")
+
+#define BRANCH_ENUM(p)                  branch_##p,
+#define LOADUSE_ENUM(d)                 loaduse_d##d,
+#define DIV_ENUM(op, mag, n, d)         div_##op##_##mag,
+#define DIV_ENUM_OP(op)                 DIV_MAGS(DIV_ENUM, op)
+#define STLF_ENUM(ident, name, st, ld)  stlf_##ident,
+enum hazard_case_id {
+    BRANCH_PATTERNS(BRANCH_ENUM)
+    LOADUSE_DISTS(LOADUSE_ENUM)
+    DIV_OPS(DIV_ENUM_OP)
+    STLF_CASES(STLF_ENUM)
+    HAZARD_CASE_COUNT
+};
+
+#define BRANCH_INIT(p)                  { "branch", #p, branch_##p, 0, FLT_MAX, FLT_MAX },
+#define LOADUSE_INIT(d)                 { "loaduse", "d" #d, 0, 0, FLT_MAX, FLT_MAX },
+#define DIV_INIT(op, mag, n, d)         { "div", #op "." #mag, n, d, FLT_MAX, FLT_MAX },
+#define DIV_INIT_OP(op)                 DIV_MAGS(DIV_INIT, op)
+#define STLF_INIT(ident, name, st, ld)  { "stlf", name, 0, 0, FLT_MAX, FLT_MAX },
+static hazard_case_t s_cases[HAZARD_CASE_COUNT] = {
+    BRANCH_PATTERNS(BRANCH_INIT)
+    LOADUSE_DISTS(LOADUSE_INIT)
+    DIV_OPS(DIV_INIT_OP)
+    STLF_CASES(STLF_INIT)
+};
+
+static uint8_t s_patterns[branch_custom + 1][BRANCH_TABLE_LEN];
+static uint32_t s_hazard_buf[32] __attribute__((aligned(32)));
+
+// ============ SPRUNGMUSTER ============
+/**
+ * @brief xorshift32 - deterministischer Zufall für die Zufallsmuster
+ */
+static uint32_t xorshift32(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/**
+ * @brief Richtung des i-ten Sprungs eines Musters
+ * nested: innere Schleife mit 3 Durchläufen (T T N), danach die Rückkante
+ * der äußeren Schleife mit 4 Durchläufen - beide über denselben Sprung.
+ */
+static uint8_t branch_taken(uint32_t pattern, uint32_t i, uint32_t& state) {
+    static const char custom[] = CONFIG_BENCH_HAZARD_BRANCH_PATTERN;
+    uint32_t custom_len = 0;
+
+    switch (pattern) {
+    case branch_never:  return 0;
+    case branch_always: return 1;
+    case branch_alt:    return (i % 2) == 0;
+    case branch_loop4:  return (i % 4) != 3;
+    case branch_loop16: return (i % 16) != 15;
+    case branch_nested:
+        if (i % 4 < 2) {
+            return 1;
+        }
+        return (i % 4 == 2) ? 0 : (i % 16) != 15;
+    case branch_rand50: return xorshift32(state) & 1;
+    case branch_rand90: return (xorshift32(state) % 10) != 0;
+    default:
+        break;
+    }
+    // Eigenes Muster aus der Kconfig, nur T/N zählen
+    for (const char* p = custom; *p; p++) {
+        custom_len += (*p == 'T' || *p == 'N');
+    }
+    if (custom_len == 0) {
+        return 0;
+    }
+    uint32_t k = i % custom_len;
+    for (const char* p = custom; *p; p++) {
+        if (*p != 'T' && *p != 'N') {
+            continue;
+        }
+        if (k-- == 0) {
+            return *p == 'T';
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Füllt die Mustertabellen vor main (Kconfig-Muster erst zur Laufzeit bekannt)
+ */
+__attribute__((constructor)) static void init_branch_patterns(void) {
+    for (uint32_t p = 0; p <= branch_custom; p++) {
+        uint32_t state = 0x2545F491u + p;
+        for (uint32_t i = 0; i < BRANCH_TABLE_LEN; i++) {
+            s_patterns[p][i] = branch_taken(p, i, state);
+        }
+    }
+    s_hazard_buf[0] = 0x00012345;
+}
+
+// ============ KERNEL ============
+// Sprung zum direkt folgenden Befehl: genommen und nicht genommen führen
+// denselben Befehlsstrom aus, nur die Sprungrichtung unterscheidet sich.
+// Der Musterwert wird eine Runde vorher geladen (kein Load-Use-Stall).
+#define BRANCH_ASM(op) \
+    __asm__ __volatile__ ( \
+        ".option push\n" ".option norvc\n" \
+        "mv a0, %[loops]\n" "mv a4, %[table]\n" "li t0, 0\n" "li t2, 0\n" "lbu t1, 0(a4)\n" \
+        "1:\n" \
+        op \
+        "2:\n" \
+        "add t0, t0, t1\n" \
+        "addi t2, t2, 1\n" "andi t2, t2, %[mask]\n" "add t3, a4, t2\n" "lbu t1, 0(t3)\n" \
+        "addi a0, a0, -1\n" "bnez a0, 1b\n" \
+        "mv %[out], t0\n" \
+        ".option pop\n" \
+        : [out] "=r" (out) \
+        : [loops] "r" (loops), [table] "r" (s_patterns[c->a]), [mask] "i" (BRANCH_TABLE_LEN - 1) \
+        : "a0", "a4", "t0", "t1", "t2", "t3", "memory")
+
+template <bool Base>
+static uint32_t branch_kernel(const hazard_case_t* c, uint32_t loops, uint32_t* result) {
+    uint32_t out;
+    uint32_t start = get_cycle_count();
+    if constexpr (Base) {
+        BRANCH_ASM("nop\n");
+    } else {
+        BRANCH_ASM("bnez t1, 2f\n");
+    }
+    uint32_t end = get_cycle_count();
+    *result = out;
+    return timing_subtract_overhead(end - start, 0);
+}
+
+// Load, dann Dist unabhängige Befehle, dann der Verbraucher
+#define LOADUSE_ASM(consumer) \
+    __asm__ __volatile__ ( \
+        ".option push\n" ".option norvc\n" \
+        "mv a0, %[loops]\n" "mv a4, %[base]\n" "li t0, 0\n" "li t1, 0\n" "li t2, 0\n" \
+        "li t3, 0\n" "li t4, 0\n" "li t5, 0\n" "li t6, 1\n" \
+        "1:\n" \
+        ".rept %[reps]\n" \
+        "lw t0, 0(a4)\n" \
+        ".if %[dist] > 0\n addi t1, t1, 1\n.endif\n" \
+        ".if %[dist] > 1\n addi t2, t2, 1\n.endif\n" \
+        ".if %[dist] > 2\n addi t3, t3, 1\n.endif\n" \
+        ".if %[dist] > 3\n addi t4, t4, 1\n.endif\n" \
+        consumer \
+        ".endr\n" \
+        "addi a0, a0, -1\n" "bnez a0, 1b\n" \
+        "xor t5, t5, t1\n" "xor t5, t5, t2\n" "xor t5, t5, t3\n" "xor t5, t5, t4\n" \
+        "mv %[out], t5\n" \
+        ".option pop\n" \
+        : [out] "=r" (out) \
+        : [loops] "r" (loops), [base] "r" (s_hazard_buf), [reps] "i" (HAZARD_UNROLL), [dist] "i" (Dist) \
+        : "a0", "a4", "t0", "t1", "t2", "t3", "t4", "t5", "t6", "memory")
+
+template <unsigned Dist, bool Base>
+static uint32_t loaduse_kernel(const hazard_case_t* c, uint32_t loops, uint32_t* result) {
+    (void)c;
+    uint32_t out;
+    uint32_t start = get_cycle_count();
+    if constexpr (Base) {
+        LOADUSE_ASM("add t5, t5, t6\n");
+    } else {
+        LOADUSE_ASM("add t5, t5, t0\n");
+    }
+    uint32_t end = get_cycle_count();
+    *result = out;
+    return timing_subtract_overhead(end - start, 0);
+}
+
+// Abhängige Kette mit festem Dividenden: das Ergebnis wird zu null maskiert
+// und auf den Dividenden geodert, die Operandengröße bleibt damit konstant.
+// Die Basis ersetzt div durch add: gemeldet wird die Latenz über ADD.
+#define DIV_ASM(op) \
+    __asm__ __volatile__ ( \
+        ".option push\n" ".option norvc\n" \
+        "mv a0, %[loops]\n" "mv a2, %[dividend]\n" "mv a3, %[divisor]\n" "mv t0, a2\n" \
+        "1:\n" \
+        ".rept %[reps]\n" \
+        op " t1, t0, a3\n" "andi t1, t1, 0\n" "or t0, a2, t1\n" \
+        ".endr\n" \
+        "addi a0, a0, -1\n" "bnez a0, 1b\n" \
+        "mv %[out], t0\n" \
+        ".option pop\n" \
+        : [out] "=r" (out) \
+        : [loops] "r" (loops), [dividend] "r" (c->a), [divisor] "r" (c->b), [reps] "i" (HAZARD_UNROLL) \
+        : "a0", "a2", "a3", "t0", "t1")
+
+#define DEFINE_DIV_KERNEL(op) \
+    template <bool Base> \
+    static uint32_t div_kernel_##op(const hazard_case_t* c, uint32_t loops, uint32_t* result) { \
+        uint32_t out; \
+        uint32_t start = get_cycle_count(); \
+        if constexpr (Base) { \
+            DIV_ASM("add"); \
+        } else { \
+            DIV_ASM(#op); \
+        } \
+        uint32_t end = get_cycle_count(); \
+        *result = out; \
+        return timing_subtract_overhead(end - start, 0); \
+    }
+
+DIV_OPS(DEFINE_DIV_KERNEL)
+
+// Store, dann Load, der ihn überlappt; der Load liefert den nächsten
+// Speicherwert. Die Basis lädt von einem anderen Wort (gleiche Befehle).
+#define STLF_ASM(store, load) \
+    __asm__ __volatile__ ( \
+        ".option push\n" ".option norvc\n" \
+        "mv a0, %[loops]\n" "mv a4, %[base]\n" "li t0, 0x123\n" "li t1, 0\n" "li t2, 0\n" \
+        "1:\n" \
+        ".rept %[reps]\n" store load ".endr\n" \
+        "addi a0, a0, -1\n" "bnez a0, 1b\n" \
+        "mv %[out], t0\n" \
+        ".option pop\n" \
+        : [out] "=r" (out) \
+        : [loops] "r" (loops), [base] "r" (s_hazard_buf), [reps] "i" (HAZARD_UNROLL), \
+          [off] "i" (Base ? STLF_ALIAS_OFFSET : 0) \
+        : "a0", "a4", "t0", "t1", "t2", "memory")
+
+#define DEFINE_STLF_KERNEL(ident, name, store, load) \
+    template <bool Base> \
+    static uint32_t stlf_kernel_##ident(const hazard_case_t* c, uint32_t loops, uint32_t* result) { \
+        (void)c; \
+        uint32_t out; \
+        uint32_t start = get_cycle_count(); \
+        STLF_ASM(store, load); \
+        uint32_t end = get_cycle_count(); \
+        *result = out; \
+        return timing_subtract_overhead(end - start, 0); \
+    }
+
+STLF_CASES(DEFINE_STLF_KERNEL)
+
+/**
+ * @brief Misst Basis und Test direkt nacheinander
+ * @return Zyklen des Tests abzüglich der Basis (nicht negativ)
+ */
+template <hazard_kernel_fn Base, hazard_kernel_fn Test, unsigned Unroll>
+static uint32_t hazard_case(void* arg, uint32_t iterations, uint32_t* result) {
+    hazard_case_t* c = (hazard_case_t*)arg;
+    const uint32_t loops = iterations >= Unroll ? iterations / Unroll : 1;
+    const float events = (float)(loops * Unroll);
+    uint32_t out_base, out_test;
+
+    uint32_t base = Base(c, loops, &out_base);
+    uint32_t test = Test(c, loops, &out_test);
+
+    *result = out_base ^ out_test;
+    bench_track_min(&c->test, test / events);
+    bench_track_min(&c->base, base / events);
+    return test > base ? test - base : 0;
+}
+
+// ============ REGISTRIERUNG ============
+#define REGISTER_BRANCH(p) \
+    BENCH_REGISTER(hazard_branch_##p, "hazard.branch." #p, "micro", "hazard,branch", \
+                   HAZARD_EVENTS, 1, (hazard_case<branch_kernel<true>, branch_kernel<false>, 1>), \
+                   &s_cases[branch_##p])
+#define REGISTER_LOADUSE(d) \
+    BENCH_REGISTER(hazard_loaduse_d##d, "hazard.loaduse.d" #d, "micro", "hazard,loaduse", \
+                   HAZARD_EVENTS, HAZARD_UNROLL, \
+                   (hazard_case<loaduse_kernel<d, true>, loaduse_kernel<d, false>, HAZARD_UNROLL>), \
+                   &s_cases[loaduse_d##d])
+#define REGISTER_DIV(op, mag, n, d) \
+    BENCH_REGISTER(hazard_div_##op##_##mag, "hazard.div." #op "." #mag, "micro", "hazard,muldiv", \
+                   HAZARD_EVENTS, HAZARD_UNROLL, \
+                   (hazard_case<div_kernel_##op<true>, div_kernel_##op<false>, HAZARD_UNROLL>), \
+                   &s_cases[div_##op##_##mag])
+#define REGISTER_DIV_OP(op)     DIV_MAGS(REGISTER_DIV, op)
+#define REGISTER_STLF(ident, name, st, ld) \
+    BENCH_REGISTER(hazard_stlf_##ident, "hazard.stlf." name, "micro", "hazard,mem", \
+                   HAZARD_EVENTS, HAZARD_UNROLL, \
+                   (hazard_case<stlf_kernel_##ident<true>, stlf_kernel_##ident<false>, HAZARD_UNROLL>), \
+                   &s_cases[stlf_##ident])
+
+BRANCH_PATTERNS(REGISTER_BRANCH)
+LOADUSE_DISTS(REGISTER_LOADUSE)
+DIV_OPS(REGISTER_DIV_OP)
+STLF_CASES(REGISTER_STLF)
+
+// ============ AUSGABE ============
+static bool case_measured(const hazard_case_t* c) {
+    return c->test < FLT_MAX && c->base < FLT_MAX;
+}
+
+/**
+ * @brief Gibt Zyklen pro Ereignis je Fall aus, gruppiert nach Teil
+ * Bei rand50 liegt jeder Prädiktor im Mittel jedes zweite Mal daneben;
+ * daraus und aus never/always folgt die geschätzte Fehlvorhersage-Strafe.
+ */
+void hazard_bench_print_table(void) {
+    const char* group = NULL;
+
+    for (const hazard_case_t& c : s_cases) {
+        if (!case_measured(&c)) {
+            continue;
+        }
+        if (group == NULL) {
+            printf("\n=== PIPELINE-HAZARDS (Zyklen pro Ereignis, Minimum Test - Minimum Basis) ===\n");
+            printf("%-9s %-14s %8s %8s %8s\n", "Teil", "Fall", "Delta", "Test", "Basis");
+        }
+        if (group == NULL || strcmp(group, c.group) != 0) {
+            group = c.group;
+            printf("%-9s", group);
+        } else {
+            printf("%-9s", "");
+        }
+        printf(" %-14s %8.3f %8.3f %8.3f\n", c.variant, c.test - c.base, c.test, c.base);
+    }
+
+    const hazard_case_t* never = &s_cases[branch_never];
+    const hazard_case_t* always = &s_cases[branch_always];
+    const hazard_case_t* rand50 = &s_cases[branch_rand50];
+    if (case_measured(never) && case_measured(always) && case_measured(rand50)) {
+        float mean = 0.5f * ((never->test - never->base) + (always->test - always->base));
+        printf("Geschätzte Fehlvorhersage-Strafe: %.1f Zyklen (2 x (rand50 - Mittel never/always))\n",
+               2.0f * ((rand50->test - rand50->base) - mean));
+    }
+}
+
+#else
+
+void hazard_bench_print_table(void) {
+}
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef HAZARD_BENCH_H
+#define HAZARD_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Zyklen pro Ereignis über dem Basiskernel für alle gemessenen Hazard-Fälle
+void hazard_bench_print_table(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,239 @@
+// Tabellengesteuerte Instruktions-Kernel für RV32IMAC
+//
+// Jede Zeile in INSTR_KERNEL_LIST erzeugt bis zu zwei ausgerollte Kernel:
+//   .lat - abhängige Kette über ein Register (Latenz), nur mit kette = 1
+//   .thr - unabhängige Ketten über mehrere Register (Durchsatz)
+// Instruktionen ohne Quellabhängigkeit auf ihr Ziel (lui, auipc, c.li, Stores)
+// bilden keine Kette und haben daher nur einen .thr-Kernel.
+// Der Assembler rollt per .rept/.irp aus, die Instruktion selbst wird als
+// lokales .macro bench_op r, s eingesetzt (\r = Zielregister, \s = Quelle).
+
+#include "bench_registry.h"
+#include "measurement_utils.h"
+#include "sdkconfig.h"
+
+#if defined(__riscv)
+
+// ============ DESKRIPTOREN ============
+// Registerbelegung der Klassen:
+//   Alu/Mem:       Ketten t0..t6, a1 | a2 = Operand, a3 = 1, a4 = Puffer, a5 = 3
+//   Rvc/RvcMem:    Ketten a1, a2, a3, a5 (x8..x15 für CL/CS/CA) | a4 = Operand, s1 = Puffer
+// Mem-Klassen: Latenz ist eine Zeigerkette (Puffer[0] zeigt auf sich selbst),
+// beim Durchsatz adressieren alle Ketten den festen Puffer.
+// Division: fester Dividend (a2) und Divisor 3 (a5). andi/or setzen die Kette
+// auf den Dividenden zurück (wie hazard.div), .lat enthält also zwei ALU-Takte.
+// Abgezogen werden Messklammer, Schleifensteuerung und der Rahmen aus Prolog
+// und Epilog (kalibriert über denselben Rahmen mit leerem Rumpf).
+#define INSTR_KERNEL_LIST(X) \
+    /* ident     name            gruppe   klasse  kette  template */ \
+    X(add,       "add",          alu,     Alu,    1,     "add \\r, \\s, a2") \
+    X(sub,       "sub",          alu,     Alu,    1,     "sub \\r, \\s, a2") \
+    X(and_,      "and",          alu,     Alu,    1,     "and \\r, \\s, a2") \
+    X(or_,       "or",           alu,     Alu,    1,     "or \\r, \\s, a2") \
+    X(xor_,      "xor",          alu,     Alu,    1,     "xor \\r, \\s, a2") \
+    X(slt,       "slt",          alu,     Alu,    1,     "slt \\r, \\s, a2") \
+    X(sltu,      "sltu",         alu,     Alu,    1,     "sltu \\r, \\s, a2") \
+    X(addi,      "addi",         alu,     Alu,    1,     "addi \\r, \\s, 1") \
+    X(addi2047,  "addi2047",     alu,     Alu,    1,     "addi \\r, \\s, 2047") \
+    X(andi,      "andi",         alu,     Alu,    1,     "andi \\r, \\s, 0x7ff") \
+    X(ori,       "ori",          alu,     Alu,    1,     "ori \\r, \\s, 1") \
+    X(xori,      "xori",         alu,     Alu,    1,     "xori \\r, \\s, 1") \
+    X(slti,      "slti",         alu,     Alu,    1,     "slti \\r, \\s, 100") \
+    X(sll,       "sll",          shift,   Alu,    1,     "sll \\r, \\s, a3") \
+    X(srl,       "srl",          shift,   Alu,    1,     "srl \\r, \\s, a3") \
+    X(sra,       "sra",          shift,   Alu,    1,     "sra \\r, \\s, a3") \
+    X(slli,      "slli",         shift,   Alu,    1,     "slli \\r, \\s, 1") \
+    X(srli,      "srli",         shift,   Alu,    1,     "srli \\r, \\s, 1") \
+    X(srai,      "srai",         shift,   Alu,    1,     "srai \\r, \\s, 1") \
+    X(lui,       "lui",          upper,   Alu,    0,     "lui \\r, 0x12345") \
+    X(auipc,     "auipc",        upper,   Alu,    0,     "auipc \\r, 0") \
+    X(mul,       "mul",          muldiv,  Alu,    1,     "mul \\r, \\s, a3") \
+    X(mulh,      "mulh",         muldiv,  Alu,    1,     "mulh \\r, \\s, a2") \
+    X(mulhsu,    "mulhsu",       muldiv,  Alu,    1,     "mulhsu \\r, \\s, a2") \
+    X(mulhu,     "mulhu",        muldiv,  Alu,    1,     "mulhu \\r, \\s, a2") \
+    X(div,       "div+andi+or",  muldiv,  Alu,    1,     "div \\r, \\s, a5\n andi \\r, \\r, 0\n or \\r, a2, \\r") \
+    X(divu,      "divu+andi+or", muldiv,  Alu,    1,     "divu \\r, \\s, a5\n andi \\r, \\r, 0\n or \\r, a2, \\r") \
+    X(rem,       "rem+andi+or",  muldiv,  Alu,    1,     "rem \\r, \\s, a5\n andi \\r, \\r, 0\n or \\r, a2, \\r") \
+    X(remu,      "remu+andi+or", muldiv,  Alu,    1,     "remu \\r, \\s, a5\n andi \\r, \\r, 0\n or \\r, a2, \\r") \
+    X(lw,        "lw",           mem,     Mem,    1,     "lw \\r, 0(\\s)") \
+    X(lh,        "lh+add",       mem,     Mem,    1,     "lh \\r, 4(\\s)\n add \\r, \\r, a4") \
+    X(lhu,       "lhu+add",      mem,     Mem,    1,     "lhu \\r, 4(\\s)\n add \\r, \\r, a4") \
+    X(lb,        "lb+add",       mem,     Mem,    1,     "lb \\r, 4(\\s)\n add \\r, \\r, a4") \
+    X(lbu,       "lbu+add",      mem,     Mem,    1,     "lbu \\r, 4(\\s)\n add \\r, \\r, a4") \
+    X(sw,        "sw",           mem,     Mem,    0,     "sw a2, 8(\\s)") \
+    X(sh,        "sh",           mem,     Mem,    0,     "sh a2, 8(\\s)") \
+    X(sb,        "sb",           mem,     Mem,    0,     "sb a2, 8(\\s)") \
+    X(c_addi,    "c.addi",       rvc,     Rvc,    1,     "c.addi \\r, 1") \
+    X(c_add,     "c.add",        rvc,     Rvc,    1,     "c.add \\r, a4") \
+    X(c_mv,      "c.mv",         rvc,     Rvc,    1,     "c.mv \\r, \\s") \
+    X(c_li,      "c.li",         rvc,     Rvc,    0,     "c.li \\r, 5") \
+    X(c_slli,    "c.slli",       rvc,     Rvc,    1,     "c.slli \\r, 1") \
+    X(c_srli,    "c.srli",       rvc,     Rvc,    1,     "c.srli \\r, 1") \
+    X(c_and,     "c.and",        rvc,     Rvc,    1,     "c.and \\r, a4") \
+    X(c_lw,      "c.lw",         rvc,     RvcMem, 1,     "c.lw \\r, 0(\\s)") \
+    X(c_sw,      "c.sw",         rvc,     RvcMem, 0,     "c.sw a4, 8(\\s)")
+
+// ============ KERNEL-GERÜST ============
+enum class KernelClass { Alu, Mem, Rvc, RvcMem };
+
+constexpr bool is_rvc(KernelClass cls) {
+    return cls == KernelClass::Rvc || cls == KernelClass::RvcMem;
+}
+
+constexpr bool is_mem(KernelClass cls) {
+    return cls == KernelClass::Mem || cls == KernelClass::RvcMem;
+}
+
+template <KernelClass Cls, bool Throughput, unsigned Unroll>
+struct kernel_traits {
+    static constexpr unsigned width = Throughput ? (is_rvc(Cls) ? 4 : 8) : 1;
+    static constexpr unsigned reps = Unroll / width;
+    static_assert(Unroll % width == 0, "Unroll-Faktor muss ein Vielfaches der Registerbreite sein");
+};
+
+static constexpr uint32_t OPERAND_VALUE = 0x00012345;
+
+// Puffer[0] zeigt auf sich selbst (Zeigerkette), Puffer[1] = 0 (schmale Loads), Puffer[2..] Stores
+static uint32_t s_buffer[8] __attribute__((aligned(16)));
+
+#define BENCH_OP(tmpl)          ".macro bench_op r, s\n" tmpl "\n.endm\n"
+#define BENCH_OP_END            ".purgem bench_op\n"
+
+#define STD_PROLOGUE \
+    "mv a0, %[loops]\n" "mv a2, %[value]\n" "li a3, 1\n" "mv a4, %[base]\n" "li a5, 3\n" \
+    "mv t0, %[init]\n" "mv t1, %[init]\n" "mv t2, %[init]\n" "mv t3, %[init]\n" \
+    "mv t4, %[init]\n" "mv t5, %[init]\n" "mv t6, %[init]\n" "mv a1, %[init]\n"
+#define STD_EPILOGUE \
+    "xor t0, t0, t1\n" "xor t0, t0, t2\n" "xor t0, t0, t3\n" "xor t0, t0, t4\n" \
+    "xor t0, t0, t5\n" "xor t0, t0, t6\n" "xor t0, t0, a1\n" "mv %[out], t0\n"
+#define RVC_PROLOGUE \
+    "mv a0, %[loops]\n" "mv a4, %[value]\n" "mv s1, %[base]\n" \
+    "mv a1, %[init]\n" "mv a2, %[init]\n" "mv a3, %[init]\n" "mv a5, %[init]\n"
+#define RVC_EPILOGUE \
+    "xor a1, a1, a2\n" "xor a1, a1, a3\n" "xor a1, a1, a5\n" "mv %[out], a1\n"
+
+// Nicht-RVC-Kernel explizit unkomprimiert assemblieren
+#define NORVC(body)             ".option push\n.option norvc\n" body ".option pop\n"
+
+#define LAT_BODY(reg)           ".rept %[reps]\n bench_op " reg ", " reg "\n.endr\n"
+#define THR_BODY(regs, src)     ".rept %[reps]\n.irp r, " regs "\n bench_op \\r, " src "\n.endr\n.endr\n"
+#define STD_REGS                "t0, t1, t2, t3, t4, t5, t6, a1"
+#define RVC_REGS                "a1, a2, a3, a5"
+
+// Schleifensteuerung identisch zur Kalibrierschleife (measurement_utils.c)
+#define KERNEL_ASM(tmpl, prologue, body, epilogue) \
+    __asm__ __volatile__ ( \
+        BENCH_OP(tmpl) prologue "1:\n" body "addi a0, a0, -1\n" "bnez a0, 1b\n" epilogue BENCH_OP_END \
+        : [out] "=r" (out) \
+        : [loops] "r" (loops), [value] "r" (OPERAND_VALUE), [base] "r" (s_buffer), \
+          [init] "r" (init), [reps] "i" (T::reps) \
+        : "a0", "a1", "a2", "a3", "a4", "a5", "s1", \
+          "t0", "t1", "t2", "t3", "t4", "t5", "t6", "memory")
+
+#define DEFINE_KERNEL(ident, name, group, cls, chain, tmpl) \
+    template <bool Throughput, unsigned Unroll> \
+    static uint32_t raw_##ident(uint32_t loops, uint32_t* result) { \
+        constexpr KernelClass C = KernelClass::cls; \
+        using T = kernel_traits<C, Throughput, Unroll>; \
+        const uint32_t init = is_mem(C) ? (uint32_t)(uintptr_t)s_buffer : OPERAND_VALUE; \
+        uint32_t out; \
+        uint32_t start = get_cycle_count(); \
+        if constexpr (C == KernelClass::Alu || C == KernelClass::Mem) { \
+            if constexpr (!Throughput) { \
+                KERNEL_ASM(tmpl, STD_PROLOGUE, NORVC(LAT_BODY("t0")), STD_EPILOGUE); \
+            } else if constexpr (C == KernelClass::Alu) { \
+                KERNEL_ASM(tmpl, STD_PROLOGUE, NORVC(THR_BODY(STD_REGS, "\\r")), STD_EPILOGUE); \
+            } else { \
+                KERNEL_ASM(tmpl, STD_PROLOGUE, NORVC(THR_BODY(STD_REGS, "a4")), STD_EPILOGUE); \
+            } \
+        } else { \
+            if constexpr (!Throughput) { \
+                KERNEL_ASM(tmpl, RVC_PROLOGUE, LAT_BODY("a1"), RVC_EPILOGUE); \
+            } else if constexpr (C == KernelClass::Rvc) { \
+                KERNEL_ASM(tmpl, RVC_PROLOGUE, THR_BODY(RVC_REGS, "\\r"), RVC_EPILOGUE); \
+            } else { \
+                KERNEL_ASM(tmpl, RVC_PROLOGUE, THR_BODY(RVC_REGS, "s1"), RVC_EPILOGUE); \
+            } \
+        } \
+        uint32_t end = get_cycle_count(); \
+        *result = out; \
+        return end - start; \
+    } \
+    template <bool Throughput, unsigned Unroll> \
+    static uint32_t kernel_##ident(void* arg, uint32_t iterations, uint32_t* result) { \
+        const uint32_t loops = iterations >= Unroll ? iterations / Unroll : 1; \
+        uint32_t cycles = timing_subtract_overhead(raw_##ident<Throughput, Unroll>(loops, result), loops); \
+        uint32_t frame = frame_cycles(is_rvc(KernelClass::cls)); \
+        return cycles > frame ? cycles - frame : 0; \
+    }
+
+// ============ RAHMEN-KALIBRIERUNG ============
+// Prolog/Epilog hängen nur von der Registerbelegung ab (Std oder Rvc), nicht
+// von Latenz/Durchsatz oder der Instruktion: ein Rahmen mit leerem Rumpf und
+// einem Schleifendurchlauf misst sie zusammen mit Klammer und Schleife.
+#define FRAME_REPEATS   32
+
+static uint32_t frame_cycles(bool rvc);
+
+DEFINE_KERNEL(frame_std, "", none, Alu, 0, "")
+DEFINE_KERNEL(frame_rvc, "", none, Rvc, 0, "")
+
+/**
+ * @brief Minimum der Rahmenmessung ohne Klammer und Schleifensteuerung
+ * @param rvc true für den Rvc-Rahmen
+ * @return Zyklen für Prolog und Epilog
+ */
+static uint32_t measure_frame(bool rvc) {
+    uint32_t best = UINT32_MAX;
+    uint32_t out;
+    for (int i = 0; i < FRAME_REPEATS; i++) {
+        uint32_t raw = rvc ? raw_frame_rvc<false, 1>(1, &out) : raw_frame_std<false, 1>(1, &out);
+        if (raw < best) {
+            best = raw;
+        }
+    }
+    return timing_subtract_overhead(best, 1);
+}
+
+/**
+ * @brief Rahmenoverhead, beim ersten Aufruf außerhalb des Messfensters kalibriert
+ * @param rvc true für den Rvc-Rahmen
+ * @return Zyklen für Prolog und Epilog
+ */
+static uint32_t frame_cycles(bool rvc) {
+    static uint32_t s_frame[2];
+    static bool s_frame_valid[2];
+    if (!s_frame_valid[rvc]) {
+        s_frame[rvc] = measure_frame(rvc);
+        s_frame_valid[rvc] = true;
+    }
+    return s_frame[rvc];
+}
+
+INSTR_KERNEL_LIST(DEFINE_KERNEL)
+
+// ============ REGISTRIERUNG ============
+#define KERNEL_OPS  (CONFIG_BENCH_KERNEL_LOOPS * CONFIG_BENCH_KERNEL_UNROLL)
+
+// PMU-Ereignisse nur auf Anforderung (bench -p, CONFIG_BENCH_PMU_DEFAULT_EVENTS)
+// .lat nur für Zeilen mit kette = 1
+#define REGISTER_LAT_0(ident, name, group)
+#define REGISTER_LAT_1(ident, name, group) \
+    BENCH_REGISTER(ident##_lat, name ".lat", "micro", #group ",latency", KERNEL_OPS, \
+                   CONFIG_BENCH_KERNEL_UNROLL, (kernel_##ident<false, CONFIG_BENCH_KERNEL_UNROLL>), NULL)
+
+#define REGISTER_KERNEL(ident, name, group, cls, chain, tmpl) \
+    REGISTER_LAT_##chain(ident, name, group) \
+    BENCH_REGISTER(ident##_thr, name ".thr", "micro", #group ",throughput", KERNEL_OPS, \
+                   CONFIG_BENCH_KERNEL_UNROLL, (kernel_##ident<true, CONFIG_BENCH_KERNEL_UNROLL>), NULL)
+
+INSTR_KERNEL_LIST(REGISTER_KERNEL)
+
+/**
+ * @brief Initialisiert den Speicherpuffer vor main (Zeigerkette)
+ */
+__attribute__((constructor)) static void init_kernel_buffer(void) {
+    s_buffer[0] = (uint32_t)(uintptr_t)s_buffer;
+}
+
+#endif
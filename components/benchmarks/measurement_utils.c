@@ -0,0 +1,205 @@
+#include "measurement_utils.h"
+#include <stdio.h>
+#include <inttypes.h>
+
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#else
+#include "esp_timer.h"
+#include "esp_clk_tree.h"
+#endif
+
+// ============ KONFIGURATION ============
+#define CALIBRATION_REPEATS     64      // Wiederholungen pro Kalibriermessung (Minimum zählt)
+#define CALIBRATION_LOOP_SHORT  1000    // Iterationen der kurzen Leerschleife
+#define CALIBRATION_LOOP_LONG   2000    // Iterationen der langen Leerschleife
+
+static timing_calibration_t s_calibration;
+static int s_calibrated;
+
+// ============ ZEITBASIS ============
+/**
+ * @brief Gibt aktuelle Zeit in Mikrosekunden zurück
+ * @return Zeit in Mikrosekunden
+ */
+uint64_t get_time_us(void) {
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+/**
+ * @brief Aktives Warten für eine feste Anzahl Zyklen
+ * @param cycles Anzahl der Zyklen
+ */
+void precise_delay_cycles(uint32_t cycles) {
+    uint32_t start = get_cycle_count();
+    while ((uint32_t)(get_cycle_count() - start) < cycles) {
+    }
+}
+
+/**
+ * @brief Ermittelt die CPU-Frequenz zur Laufzeit
+ * Auf dem linux-Target wird die Zählerfrequenz gegen CLOCK_MONOTONIC vermessen.
+ * @return Frequenz des Zykluszählers in MHz
+ */
+static uint32_t detect_cpu_freq_mhz(void) {
+#if CONFIG_IDF_TARGET_LINUX
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t start_us = get_time_us();
+    uint32_t start_cycles = get_cycle_count();
+    while (get_time_us() - start_us < 10000) {
+    }
+    uint32_t cycles = get_cycle_count() - start_cycles;
+    uint64_t elapsed_us = get_time_us() - start_us;
+    return (uint32_t)((cycles + elapsed_us / 2) / elapsed_us);
+#else
+    return 1000; // clock_gettime()-Backend zählt Nanosekunden
+#endif
+#else
+    uint32_t freq_hz = 0;
+    if (esp_clk_tree_src_get_freq_hz(SOC_MOD_CLK_CPU, ESP_CLK_TREE_SRC_FREQ_PRECISION_CACHED,
+                                     &freq_hz) != ESP_OK || freq_hz == 0) {
+        return 0;
+    }
+    return freq_hz / 1000000;
+#endif
+}
+
+// ============ KALIBRIERUNG ============
+/**
+ * @brief Leere Zählschleife mit derselben Schleifensteuerung wie die Kernel
+ * @param iterations Anzahl der Iterationen (>= 1)
+ * @return Gemessene Rohzyklen
+ */
+static uint32_t __attribute__((noinline)) measure_empty_loop(uint32_t iterations) {
+    uint32_t start = get_cycle_count();
+#if defined(__riscv)
+    __asm__ __volatile__ (
+        "1:\n"
+        "addi %0, %0, -1\n"    // Zähler dekrementieren
+        "bnez %0, 1b\n"        // Schleife
+        : "+r" (iterations)
+    );
+#else
+    while (iterations != 0) {
+        __asm__ __volatile__ ("" : "+r" (iterations));
+        iterations--;
+    }
+#endif
+    return get_cycle_count() - start;
+}
+
+/**
+ * @brief Minimum der leeren Messklammer über mehrere Wiederholungen
+ * @return Overhead in Zyklen
+ */
+static uint32_t measure_bracket(void) {
+    uint32_t best = UINT32_MAX;
+    for (int i = 0; i < CALIBRATION_REPEATS; i++) {
+        uint32_t start = get_cycle_count();
+        uint32_t end = get_cycle_count();
+        if (end - start < best) {
+            best = end - start;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Minimum einer Leerschleifen-Messung über mehrere Wiederholungen
+ * @param iterations Anzahl der Iterationen
+ * @return Rohzyklen
+ */
+static uint32_t measure_loop_min(uint32_t iterations) {
+    uint32_t best = UINT32_MAX;
+    for (int i = 0; i < CALIBRATION_REPEATS; i++) {
+        uint32_t cycles = measure_empty_loop(iterations);
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Bestimmt Messklammer- und Schleifenoverhead
+ * Der Schleifenoverhead ergibt sich aus der Differenz zweier Leerschleifen
+ * unterschiedlicher Länge, damit Aufruf- und Setup-Kosten herausfallen.
+ */
+void timing_calibrate(void) {
+    s_calibration.cpu_freq_mhz = detect_cpu_freq_mhz();
+    s_calibration.bracket_cycles = measure_bracket();
+
+    uint32_t short_cycles = measure_loop_min(CALIBRATION_LOOP_SHORT);
+    uint32_t long_cycles = measure_loop_min(CALIBRATION_LOOP_LONG);
+    uint32_t delta = long_cycles > short_cycles ? long_cycles - short_cycles : 0;
+    s_calibration.loop_cycles_x256 = (uint32_t)(((uint64_t)delta * 256) /
+                                               (CALIBRATION_LOOP_LONG - CALIBRATION_LOOP_SHORT));
+    s_calibrated = 1;
+
+    printf("Kalibrierung: CPU %" PRIu32 " MHz, Messklammer %" PRIu32 " Zyklen, "
+           "Schleife %" PRIu32 ".%02" PRIu32 " Zyklen/Iteration\n",
+           s_calibration.cpu_freq_mhz, s_calibration.bracket_cycles,
+           s_calibration.loop_cycles_x256 >> 8,
+           ((s_calibration.loop_cycles_x256 & 0xFF) * 100) >> 8);
+}
+
+/**
+ * @brief Liefert die Kalibrierdaten (kalibriert bei Bedarf)
+ * @return Zeiger auf die Kalibrierdaten
+ */
+const timing_calibration_t* timing_get_calibration(void) {
+    if (!s_calibrated) {
+        timing_calibrate();
+    }
+    return &s_calibration;
+}
+
+/**
+ * @brief Zur Laufzeit ermittelte CPU-Frequenz
+ * @return Frequenz in MHz
+ */
+uint32_t get_cpu_freq_mhz(void) {
+    return timing_get_calibration()->cpu_freq_mhz;
+}
+
+/**
+ * @brief Zieht Messklammer- und Schleifenoverhead von einer Rohmessung ab
+ * @param raw_cycles Gemessene Rohzyklen
+ * @param loop_iterations Anzahl der Schleifendurchläufe (0 = nur Messklammer)
+ * @return Korrigierte Zyklen (nie negativ)
+ */
+uint32_t timing_subtract_overhead(uint32_t raw_cycles, uint32_t loop_iterations) {
+    const timing_calibration_t* cal = timing_get_calibration();
+    uint64_t overhead = cal->bracket_cycles +
+                        (((uint64_t)cal->loop_cycles_x256 * loop_iterations) >> 8);
+    return raw_cycles > overhead ? raw_cycles - (uint32_t)overhead : 0;
+}
+
+/**
+ * @brief Rechnet Zyklen in Mikrosekunden um
+ * @param cycles Anzahl der Zyklen
+ * @return Zeit in Mikrosekunden
+ */
+double cycles_to_us(uint32_t cycles) {
+    uint32_t freq = get_cpu_freq_mhz();
+    return freq ? (double)cycles / freq : 0.0;
+}
+
+// ============ DATENAUSGABE ============
+/**
+ * @brief Gibt Minimum, Maximum, Mittelwert und Summe einer Messreihe aus
+ * @param min Kleinster Wert
+ * @param max Größter Wert
+ * @param avg Mittelwert
+ * @param total Summe aller Werte
+ */
+void print_statistics(uint64_t min, uint64_t max, uint64_t avg, uint64_t total) {
+    printf("Statistik: min=%" PRIu64 " max=%" PRIu64 " avg=%" PRIu64 " total=%" PRIu64 "\n",
+           min, max, avg, total);
+}
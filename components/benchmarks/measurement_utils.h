@@ -2,12 +2,59 @@
 #define MEASUREMENT_UTILS_H
 
 #include <stdint.h>
+#include "sdkconfig.h"
+
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#else
+#include "esp_cpu.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Kalibrierte Messoverheads (einmalig per timing_calibrate() bestimmt)
+typedef struct {
+    uint32_t bracket_cycles;        // Leere Messklammer get_cycle_count() -> get_cycle_count()
+    uint32_t loop_cycles_x256;      // Schleifensteuerung (addi + bnez) pro Iteration, Festkomma Q8
+    uint32_t cpu_freq_mhz;          // Zur Laufzeit ermittelte CPU-Frequenz
+} timing_calibration_t;
 
 // Zeitmessung
 uint64_t get_time_us(void);
-uint32_t get_cycle_count(void);
 void precise_delay_cycles(uint32_t cycles);
 
+/**
+ * @brief Liest den Zykluszähler der CPU
+ * Auf dem Target das RISC-V Performance-Counter-CSR, auf dem linux-Target
+ * den TSC (x86) bzw. clock_gettime() in Nanosekunden.
+ * @return Aktueller Zählerstand (läuft über, Differenzen unsigned bilden)
+ */
+static inline __attribute__((always_inline)) uint32_t get_cycle_count(void) {
+#if CONFIG_IDF_TARGET_LINUX
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+#endif
+#else
+    return (uint32_t)esp_cpu_get_cycle_count();
+#endif
+}
+
+// Kalibrierung und Umrechnung
+void timing_calibrate(void);
+const timing_calibration_t* timing_get_calibration(void);
+uint32_t get_cpu_freq_mhz(void);
+uint32_t timing_subtract_overhead(uint32_t raw_cycles, uint32_t loop_iterations);
+double cycles_to_us(uint32_t cycles);
+
 // GPIO Utilities
 void setup_gpio_output(int gpio_num);
 void toggle_gpio_fast(int gpio_num);
@@ -19,4 +66,8 @@ void print_statistics(uint64_t min, uint64_t max, uint64_t avg, uint64_t total);
 // Interrupt Utilities
 void setup_gpio_interrupt(int gpio_num, void* handler);
 
-#endif
\ No newline at end of file
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,525 @@
+// Speicherhierarchie: Zeigerketten-Latenz und Kopier-/Füll-Bandbreite
+//
+// Latenz: zufällige zyklische Zeigerkette (Sattolo) über eine Arbeitsmenge,
+// jeder Load hängt vom vorherigen ab. Über Größe und Schrittweite ergibt
+// sich die Latenzkurve (Cache-Größe, Flash-Miss-Strafe).
+//   hp     - HP SRAM (Heap, zur Laufzeit aufgebaut)
+//   lp     - LP SRAM (RTC_NOINIT, zur Laufzeit aufgebaut)
+//   flash  - rodata im Flash über Cache/MMU (zur Compile-Zeit aufgebaut)
+// Ein Kettenschritt ist ein Load plus eine Addition (Offset -> Adresse).
+
+#include "mem_bench.h"
+#include "bench_registry.h"
+#include "measurement_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_attr.h"
+#endif
+
+// ============ KONFIGURATION ============
+#define CHASE_UNROLL            8
+#define CHASE_MIN_STEPS         1024
+#define CHASE_MIN_BYTES         1024
+#define FLASH_LINE_BYTES        32                          // Cache-Zeile, ein Slot pro Wort
+#define FLASH_CLASSES           (FLASH_LINE_BYTES / 4)      // Arbeitsmengen im Flash-Block
+#define FLASH_BYTES             (CONFIG_BENCH_MEM_FLASH_KB * 1024)
+#define HP_BYTES                (CONFIG_BENCH_MEM_HP_MAX_KB * 1024)
+#if !CONFIG_IDF_TARGET_LINUX
+#define LP_BYTES                (CONFIG_BENCH_MEM_LP_KB * 1024)
+#endif
+#define BW_MAX_BYTES            32768
+#define BW_UNROLL_BYTES         32
+
+#define MAX_CHASE_CASES         48
+#define MAX_BW_CASES            24
+#define MAX_NAME_LEN            28
+
+static const uint32_t k_strides[] = { 4, 32, 128 };
+static const uint32_t k_bw_sizes[] = { 256, 4096, BW_MAX_BYTES };
+
+// ============ KETTENAUFBAU ============
+/**
+ * @brief xorshift32 - deterministischer Zufall, auch zur Compile-Zeit
+ */
+static constexpr uint32_t xorshift32(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/**
+ * @brief Baut eine zyklische Zeigerkette über alle Knoten (Sattolo)
+ * Erst Indizes permutieren, dann in Byte-Offsets umrechnen - kein Hilfsspeicher.
+ * @param base Basis des Speicherblocks
+ * @param nodes Anzahl Knoten (Arbeitsmenge / stride)
+ * @param stride Abstand der Knoten in Byte (Vielfaches von 4)
+ * @param slot Wortindex innerhalb eines Knotens
+ * @param seed Startwert des Zufallsgenerators
+ */
+static constexpr void chase_build(uint32_t* base, uint32_t nodes, uint32_t stride, uint32_t slot, uint32_t seed) {
+    const uint32_t step = stride / 4;
+    uint32_t state = seed ? seed : 1;
+
+    for (uint32_t i = 0; i < nodes; i++) {
+        base[i * step + slot] = i;
+    }
+    // Sattolo: j < i erzwingt genau einen Zyklus über alle Knoten
+    for (uint32_t i = nodes - 1; i > 0 && nodes > 1; i--) {
+        uint32_t j = xorshift32(state) % i;
+        uint32_t tmp = base[i * step + slot];
+        base[i * step + slot] = base[j * step + slot];
+        base[j * step + slot] = tmp;
+    }
+    for (uint32_t i = 0; i < nodes; i++) {
+        base[i * step + slot] = base[i * step + slot] * stride + slot * 4;
+    }
+}
+
+/**
+ * @brief Läuft die Kette ab Knoten 0 bis zum Rücksprung
+ * @return Zykluslänge in Knoten, 0 wenn max_steps überschritten
+ */
+static constexpr uint32_t chase_cycle_length(const uint32_t* base, uint32_t slot, uint32_t max_steps) {
+    const uint32_t start = slot * 4;
+    uint32_t off = start;
+    for (uint32_t n = 1; n <= max_steps; n++) {
+        off = base[off / 4];
+        if (off == start) {
+            return n;
+        }
+    }
+    return 0;
+}
+
+void mem_chase_build(uint32_t* base, uint32_t nodes, uint32_t stride, uint32_t slot, uint32_t seed) {
+    chase_build(base, nodes, stride, slot, seed);
+}
+
+uint32_t mem_chase_cycle_length(const uint32_t* base, uint32_t slot, uint32_t max_steps) {
+    return chase_cycle_length(base, slot, max_steps);
+}
+
+// ============ FLASH-RODATA ============
+// Ein Block, acht Arbeitsmengen: Klasse c nutzt Wort c jeder Cache-Zeile und
+// verkettet die ersten (Zeilen >> c) Zeilen. So passen alle Größen in eine Tabelle.
+static_assert((FLASH_BYTES & (FLASH_BYTES - 1)) == 0, "Flash-Tabelle muss eine Zweierpotenz sein");
+
+struct flash_chase_table {
+    uint32_t words[FLASH_BYTES / 4];
+};
+
+static constexpr uint32_t flash_class_lines(uint32_t cls) {
+    return (FLASH_BYTES / FLASH_LINE_BYTES) >> cls;
+}
+
+static constexpr flash_chase_table make_flash_chase(void) {
+    flash_chase_table table{};
+    for (uint32_t cls = 0; cls < FLASH_CLASSES && flash_class_lines(cls) > 0; cls++) {
+        chase_build(table.words, flash_class_lines(cls), FLASH_LINE_BYTES, cls, 0x9E3779B9u + cls);
+    }
+    return table;
+}
+
+static constexpr flash_chase_table s_flash_chase = make_flash_chase();
+
+static constexpr bool flash_chase_valid(void) {
+    for (uint32_t cls = 0; cls < FLASH_CLASSES && flash_class_lines(cls) > 0; cls++) {
+        if (chase_cycle_length(s_flash_chase.words, cls, flash_class_lines(cls)) != flash_class_lines(cls)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(flash_chase_valid(), "Flash-Zeigerkette ist kein einzelner Zyklus");
+
+// ============ REGIONEN ============
+enum mem_region { REGION_HP, REGION_LP, REGION_FLASH, REGION_COUNT };
+
+struct chase_case_t {
+    uint8_t region;
+    uint8_t slot;
+    uint32_t bytes;             // Arbeitsmenge
+    uint32_t stride;
+    float best;                 // Minimum Zyklen pro Zugriff
+};
+
+struct region_t {
+    const char* name;
+    uint8_t* buffer;
+    uint32_t bytes;
+    const chase_case_t* built;  // Aktuell aufgebaute Kette
+};
+
+#if !CONFIG_IDF_TARGET_LINUX
+static RTC_NOINIT_ATTR uint32_t s_lp_buffer[LP_BYTES / 4];
+#endif
+
+static region_t s_regions[REGION_COUNT] = {
+    { "hp", NULL, HP_BYTES, NULL },
+#if !CONFIG_IDF_TARGET_LINUX
+    { "lp", (uint8_t*)s_lp_buffer, LP_BYTES, NULL },
+#else
+    { "lp", NULL, 0, NULL },
+#endif
+    { "flash", (uint8_t*)s_flash_chase.words, FLASH_BYTES, NULL },
+};
+
+/**
+ * @brief Stellt die Kette eines Falls bereit (außerhalb des Messfensters)
+ * @return Basisadresse oder NULL, wenn kein Speicher verfügbar ist
+ */
+static const uint8_t* chase_prepare(const chase_case_t* c) {
+    region_t* region = &s_regions[c->region];
+
+    if (c->region == REGION_FLASH) {
+        return region->buffer;
+    }
+    if (region->buffer == NULL) {
+        region->buffer = (uint8_t*)malloc(region->bytes);
+        if (region->buffer == NULL) {
+            printf("Speicher-Benchmark: %" PRIu32 " Byte %s nicht verfügbar\n", region->bytes, region->name);
+            return NULL;
+        }
+    }
+    if (region->built != c) {
+        chase_build((uint32_t*)region->buffer, c->bytes / c->stride, c->stride, c->slot, c->bytes ^ c->stride);
+        region->built = c;
+    }
+    return region->buffer;
+}
+
+// ============ LATENZ ============
+#define CHASE_STEP      off = *(const volatile uint32_t*)(base + off);
+
+/**
+ * @brief Läuft iterations Schritte der Kette ab
+ * Die Kette wird vor dem Messfenster aufgebaut, das Ergebnis ist der letzte Offset.
+ * Abgezogen wird die Schleifensteuerung pro Durchlauf (CHASE_UNROLL Schritte).
+ */
+static uint32_t bench_chase(void* arg, uint32_t iterations, uint32_t* result) {
+    chase_case_t* c = (chase_case_t*)arg;
+    const uint8_t* base = chase_prepare(c);
+    if (base == NULL) {
+        *result = 0;
+        return 0;
+    }
+
+    uint32_t off = c->slot * 4;
+    uint32_t start = get_cycle_count();
+    for (uint32_t i = 0; i < iterations; i += CHASE_UNROLL) {
+        CHASE_STEP CHASE_STEP CHASE_STEP CHASE_STEP
+        CHASE_STEP CHASE_STEP CHASE_STEP CHASE_STEP
+    }
+    uint32_t end = get_cycle_count();
+
+    *result = off;
+    const uint32_t loops = (iterations + CHASE_UNROLL - 1) / CHASE_UNROLL;
+    uint32_t cycles = timing_subtract_overhead(end - start, loops);
+    bench_track_min(&c->best, (float)cycles / iterations);
+    return cycles;
+}
+
+// ============ BANDBREITE ============
+enum bw_kind {
+    BW_COPY_BYTE, BW_COPY_WORD, BW_COPY_UNROLL, BW_COPY_MEMCPY,
+    BW_FILL_BYTE, BW_FILL_WORD, BW_FILL_UNROLL, BW_FILL_MEMSET,
+    BW_KIND_COUNT
+};
+
+static const char* const k_bw_names[BW_KIND_COUNT] = {
+    "copy.byte", "copy.word", "copy.unroll", "copy.memcpy",
+    "fill.byte", "fill.word", "fill.unroll", "fill.memset",
+};
+
+struct bw_case_t {
+    uint8_t kind;
+    uint32_t bytes;
+    float best;                 // Minimum Zyklen pro Byte
+};
+
+static uint8_t* s_bw_src;
+static uint8_t* s_bw_dst;
+
+#define FILL_PATTERN    0xA5A5A5A5u
+
+// Der Compiler darf die Schleifen nicht selbst durch memcpy/memset ersetzen
+#define NO_LIBCALL      __attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+
+NO_LIBCALL static void copy_byte(uint8_t* __restrict dst, const uint8_t* __restrict src, uint32_t bytes) {
+    for (uint32_t i = 0; i < bytes; i++) {
+        dst[i] = src[i];
+    }
+}
+
+NO_LIBCALL static void copy_word(uint32_t* __restrict dst, const uint32_t* __restrict src, uint32_t bytes) {
+    for (uint32_t i = 0; i < bytes / 4; i++) {
+        dst[i] = src[i];
+    }
+}
+
+NO_LIBCALL static void copy_unroll(uint32_t* __restrict dst, const uint32_t* __restrict src, uint32_t bytes) {
+    // Erst acht Loads, dann acht Stores: Load-Latenz wird überlappt
+    for (uint32_t i = 0; i < bytes / 4; i += 8) {
+        uint32_t w0 = src[i + 0], w1 = src[i + 1], w2 = src[i + 2], w3 = src[i + 3];
+        uint32_t w4 = src[i + 4], w5 = src[i + 5], w6 = src[i + 6], w7 = src[i + 7];
+        dst[i + 0] = w0; dst[i + 1] = w1; dst[i + 2] = w2; dst[i + 3] = w3;
+        dst[i + 4] = w4; dst[i + 5] = w5; dst[i + 6] = w6; dst[i + 7] = w7;
+    }
+}
+
+NO_LIBCALL static void fill_byte(uint8_t* dst, uint32_t bytes) {
+    for (uint32_t i = 0; i < bytes; i++) {
+        dst[i] = (uint8_t)FILL_PATTERN;
+    }
+}
+
+NO_LIBCALL static void fill_word(uint32_t* dst, uint32_t bytes) {
+    for (uint32_t i = 0; i < bytes / 4; i++) {
+        dst[i] = FILL_PATTERN;
+    }
+}
+
+NO_LIBCALL static void fill_unroll(uint32_t* dst, uint32_t bytes) {
+    for (uint32_t i = 0; i < bytes / 4; i += 8) {
+        dst[i + 0] = FILL_PATTERN; dst[i + 1] = FILL_PATTERN; dst[i + 2] = FILL_PATTERN; dst[i + 3] = FILL_PATTERN;
+        dst[i + 4] = FILL_PATTERN; dst[i + 5] = FILL_PATTERN; dst[i + 6] = FILL_PATTERN; dst[i + 7] = FILL_PATTERN;
+    }
+}
+
+/**
+ * @brief Kopiert oder füllt iterations Byte im HP SRAM
+ * iterations wird auf BW_MAX_BYTES begrenzt, Ergebnis sind erstes und letztes Wort.
+ */
+static uint32_t bench_bandwidth(void* arg, uint32_t iterations, uint32_t* result) {
+    bw_case_t* c = (bw_case_t*)arg;
+    uint32_t bytes = iterations < BW_MAX_BYTES ? iterations : BW_MAX_BYTES;
+
+    if (s_bw_src == NULL) {
+        s_bw_src = (uint8_t*)malloc(BW_MAX_BYTES);
+        s_bw_dst = (uint8_t*)malloc(BW_MAX_BYTES);
+        if (s_bw_src == NULL || s_bw_dst == NULL) {
+            printf("Speicher-Benchmark: Kopierpuffer nicht verfügbar\n");
+            free(s_bw_src);
+            free(s_bw_dst);
+            s_bw_src = s_bw_dst = NULL;
+            *result = 0;
+            return 0;
+        }
+        for (uint32_t i = 0; i < BW_MAX_BYTES; i++) {
+            s_bw_src[i] = (uint8_t)(i * 7 + 1);
+        }
+    }
+
+    uint8_t* dst = s_bw_dst;
+    const uint8_t* src = s_bw_src;
+    uint32_t start = get_cycle_count();
+    switch (c->kind) {
+    case BW_COPY_BYTE:   copy_byte(dst, src, bytes); break;
+    case BW_COPY_WORD:   copy_word((uint32_t*)dst, (const uint32_t*)src, bytes); break;
+    case BW_COPY_UNROLL: copy_unroll((uint32_t*)dst, (const uint32_t*)src, bytes); break;
+    case BW_COPY_MEMCPY: memcpy(dst, src, bytes); break;
+    case BW_FILL_BYTE:   fill_byte(dst, bytes); break;
+    case BW_FILL_WORD:   fill_word((uint32_t*)dst, bytes); break;
+    case BW_FILL_UNROLL: fill_unroll((uint32_t*)dst, bytes); break;
+    case BW_FILL_MEMSET: memset(dst, (uint8_t)FILL_PATTERN, bytes); break;
+    default: break;
+    }
+    uint32_t end = get_cycle_count();
+
+    *result = ((const uint32_t*)dst)[0] ^ ((const uint32_t*)dst)[bytes / 4 - 1];
+    uint32_t cycles = timing_subtract_overhead(end - start, 0);
+    bench_track_min(&c->best, (float)cycles / bytes);
+    return cycles;
+}
+
+// ============ REGISTRIERUNG ============
+static chase_case_t s_chase_cases[MAX_CHASE_CASES];
+static bw_case_t s_bw_cases[MAX_BW_CASES];
+static bench_def_t s_defs[MAX_CHASE_CASES + MAX_BW_CASES];
+static char s_names[MAX_CHASE_CASES + MAX_BW_CASES][MAX_NAME_LEN];
+static uint32_t s_chase_count;
+static uint32_t s_bw_count;
+static uint32_t s_def_count;
+
+/**
+ * @brief Größe kompakt formatieren (256, 4K, 128K)
+ */
+static void format_size(char* out, size_t len, uint32_t bytes) {
+    if (bytes >= 1024) {
+        snprintf(out, len, "%" PRIu32 "K", bytes / 1024);
+    } else {
+        snprintf(out, len, "%" PRIu32, bytes);
+    }
+}
+
+static void add_def(const char* tags, uint32_t iterations, uint32_t granularity, bench_fn_t fn, void* arg) {
+    bench_def_t* def = &s_defs[s_def_count];
+    def->name = s_names[s_def_count];
+    def->suite = "memory";
+    def->tags = tags;
+    def->iterations = iterations;
+    def->granularity = granularity;
+    def->fn = fn;
+    def->arg = arg;
+    def->test_id = BENCH_TEST_ID_NONE;
+    bench_register(def);
+    s_def_count++;
+}
+
+static void add_chase(uint8_t region, uint32_t bytes, uint32_t stride, uint8_t slot) {
+    if (s_chase_count >= MAX_CHASE_CASES) {
+        return;
+    }
+    chase_case_t* c = &s_chase_cases[s_chase_count++];
+    c->region = region;
+    c->slot = slot;
+    c->bytes = bytes;
+    c->stride = stride;
+    c->best = FLT_MAX;
+
+    // Mindestens zwei Umläufe, damit kalte Zugriffe nur das erste Sample prägen
+    uint32_t steps = 2 * (bytes / stride);
+    steps = steps < CHASE_MIN_STEPS ? CHASE_MIN_STEPS : steps;
+    steps = (steps + CHASE_UNROLL - 1) / CHASE_UNROLL * CHASE_UNROLL;
+
+    char size[12];
+    format_size(size, sizeof(size), bytes);
+    snprintf(s_names[s_def_count], MAX_NAME_LEN, "chase.%s.s%" PRIu32 ".%s", s_regions[region].name, stride, size);
+    add_def(region == REGION_FLASH ? "latency,flash" : region == REGION_LP ? "latency,lp" : "latency,hp",
+            steps, CHASE_UNROLL, bench_chase, c);
+}
+
+/**
+ * @brief Registriert alle Speicher-Benchmarks vor app_main()
+ */
+__attribute__((constructor)) static void mem_bench_register(void) {
+    for (uint32_t bytes = CHASE_MIN_BYTES; bytes <= HP_BYTES; bytes *= 2) {
+        for (size_t s = 0; s < sizeof(k_strides) / sizeof(k_strides[0]); s++) {
+            add_chase(REGION_HP, bytes, k_strides[s], 0);
+        }
+    }
+#if !CONFIG_IDF_TARGET_LINUX
+    for (uint32_t bytes = CHASE_MIN_BYTES; bytes <= LP_BYTES; bytes *= 2) {
+        for (size_t s = 0; s < sizeof(k_strides) / sizeof(k_strides[0]); s++) {
+            add_chase(REGION_LP, bytes, k_strides[s], 0);
+        }
+    }
+#endif
+    for (uint32_t cls = 0; cls < FLASH_CLASSES && flash_class_lines(cls) > 0; cls++) {
+        uint32_t bytes = flash_class_lines(cls) * FLASH_LINE_BYTES;
+        if (bytes >= CHASE_MIN_BYTES) {
+            add_chase(REGION_FLASH, bytes, FLASH_LINE_BYTES, (uint8_t)cls);
+        }
+    }
+
+    for (uint32_t kind = 0; kind < BW_KIND_COUNT; kind++) {
+        for (size_t s = 0; s < sizeof(k_bw_sizes) / sizeof(k_bw_sizes[0]) && s_bw_count < MAX_BW_CASES; s++) {
+            bw_case_t* c = &s_bw_cases[s_bw_count++];
+            c->kind = (uint8_t)kind;
+            c->bytes = k_bw_sizes[s];
+            c->best = FLT_MAX;
+
+            char size[12];
+            format_size(size, sizeof(size), c->bytes);
+            snprintf(s_names[s_def_count], MAX_NAME_LEN, "%s.%s", k_bw_names[kind], size);
+            add_def(kind < BW_FILL_BYTE ? "bandwidth,copy" : "bandwidth,fill",
+                    c->bytes, BW_UNROLL_BYTES, bench_bandwidth, c);
+        }
+    }
+}
+
+// ============ AUSGABE ============
+/**
+ * @brief Gibt Latenz (Zyklen pro Zugriff) und Bandbreite (Zyklen pro Byte)
+ * als Tabellen Größe x Region/Schrittweite bzw. Größe x Kernel aus
+ * Es zählt jeweils das Minimum über alle Samples; nicht gemessene Zellen bleiben "-".
+ */
+void mem_bench_print_curves(void) {
+    // Spalten: Region/Schrittweite in Registrierungsreihenfolge
+    const chase_case_t* columns[MAX_CHASE_CASES];
+    uint32_t column_count = 0;
+    uint32_t max_bytes = 0;
+    bool measured = false;
+
+    for (uint32_t i = 0; i < s_chase_count; i++) {
+        const chase_case_t* c = &s_chase_cases[i];
+        bool known = false;
+        for (uint32_t k = 0; k < column_count; k++) {
+            known |= columns[k]->region == c->region && columns[k]->stride == c->stride;
+        }
+        if (!known) {
+            columns[column_count++] = c;
+        }
+        max_bytes = c->bytes > max_bytes ? c->bytes : max_bytes;
+        measured |= c->best < FLT_MAX;
+    }
+
+    if (measured) {
+        printf("\n=== SPEICHER-LATENZ (Zyklen pro Zugriff, Minimum) ===\n%8s", "Groesse");
+        for (uint32_t k = 0; k < column_count; k++) {
+            char label[16];
+            snprintf(label, sizeof(label), "%s/s%" PRIu32, s_regions[columns[k]->region].name, columns[k]->stride);
+            printf(" %10s", label);
+        }
+        printf("\n");
+        for (uint32_t bytes = CHASE_MIN_BYTES; bytes <= max_bytes; bytes *= 2) {
+            char size[12];
+            format_size(size, sizeof(size), bytes);
+            printf("%8s", size);
+            for (uint32_t k = 0; k < column_count; k++) {
+                const chase_case_t* cell = NULL;
+                for (uint32_t i = 0; i < s_chase_count; i++) {
+                    const chase_case_t* c = &s_chase_cases[i];
+                    if (c->region == columns[k]->region && c->stride == columns[k]->stride && c->bytes == bytes) {
+                        cell = c;
+                    }
+                }
+                if (cell != NULL && cell->best < FLT_MAX) {
+                    printf(" %10.2f", cell->best);
+                } else {
+                    printf(" %10s", "-");
+                }
+            }
+            printf("\n");
+        }
+    }
+
+    measured = false;
+    for (uint32_t i = 0; i < s_bw_count; i++) {
+        measured |= s_bw_cases[i].best < FLT_MAX;
+    }
+    if (!measured) {
+        return;
+    }
+    printf("\n=== SPEICHER-BANDBREITE HP SRAM (Zyklen pro Byte, Minimum) ===\n%8s", "Groesse");
+    for (uint32_t kind = 0; kind < BW_KIND_COUNT; kind++) {
+        printf(" %12s", k_bw_names[kind]);
+    }
+    printf("\n");
+    for (size_t s = 0; s < sizeof(k_bw_sizes) / sizeof(k_bw_sizes[0]); s++) {
+        char size[12];
+        format_size(size, sizeof(size), k_bw_sizes[s]);
+        printf("%8s", size);
+        for (uint32_t kind = 0; kind < BW_KIND_COUNT; kind++) {
+            const bw_case_t* cell = NULL;
+            for (uint32_t i = 0; i < s_bw_count; i++) {
+                if (s_bw_cases[i].kind == kind && s_bw_cases[i].bytes == k_bw_sizes[s]) {
+                    cell = &s_bw_cases[i];
+                }
+            }
+            if (cell != NULL && cell->best < FLT_MAX) {
+                printf(" %12.3f", cell->best);
+            } else {
+                printf(" %12s", "-");
+            }
+        }
+        printf("\n");
+    }
+}
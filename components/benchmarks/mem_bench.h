@@ -0,0 +1,22 @@
+#ifndef MEM_BENCH_H
+#define MEM_BENCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Zeigerkette: Knoten i liegt bei Byte-Offset i * stride + slot * 4 und
+// enthält den Byte-Offset seines Nachfolgers (relativ zur Basis)
+void mem_chase_build(uint32_t* base, uint32_t nodes, uint32_t stride, uint32_t slot, uint32_t seed);
+uint32_t mem_chase_cycle_length(const uint32_t* base, uint32_t slot, uint32_t max_steps);
+
+// Größe-über-Zyklen-Tabellen der zuletzt gemessenen Speicher-Benchmarks
+void mem_bench_print_curves(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,203 @@
+// Code-Platzierung: dieselbe ADDI-Schleife in mehreren Varianten
+//
+//   iram / flash   - IRAM_ATTR oder Flash-XIP über den Cache
+//   a2..a32        - Schleifenkopf bei Adresse = 2/4/16/32 mod 32 (genau diese Ausrichtung)
+//   rvc / norvc    - Schleife explizit mit bzw. ohne komprimierte Instruktionen
+//   warm / cold    - cold invalidiert vor jedem Sample die Cache-Zeilen des Kernels
+//
+// Die Varianten unterscheiden sich nur in Platzierung und Assembler-Optionen,
+// der Quelltext der Schleife ist für alle gleich. Abgezogen wird nur die
+// Messklammer: die Schleifensteuerung gehört hier zum Messobjekt.
+
+#include "place_bench.h"
+#include "bench_registry.h"
+#include "measurement_utils.h"
+#include <stdio.h>
+#include <float.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+
+#if defined(__riscv)
+
+#include "esp_attr.h"
+#include "hal/cache_hal.h"
+
+// ============ KONFIGURATION ============
+#define PLACE_LOOPS             256     // Schleifendurchläufe (warm)
+#define PLACE_COLD_LOOPS        1       // Ein Durchlauf: Fehlzugriffe nicht verdünnen
+#define PLACE_LINE_BYTES        32
+#define PLACE_CODE_WINDOW       1024    // Invalidierter Bereich ab Funktionsanfang
+
+enum class Placement : uint8_t { iram, flash };
+enum class Isa : uint8_t { rvc, norvc };
+enum class Cache : uint8_t { warm, cold };
+
+struct place_case_t {
+    const char* kernel;
+    Placement placement;
+    uint8_t align;
+    Isa isa;
+    Cache cache;
+    uint8_t unroll;
+    float best;                 // Minimum Zyklen pro Operation
+};
+
+// ============ VARIANTEN ============
+// Kernel: loop4 (kurze Schleife, Steuerung und Sprung dominieren), loop32
+#define PLACE_KERNELS(X) \
+    X(loop4, 4) \
+    X(loop32, 32)
+
+#define PLACE_ALIGNS(X, k, u, p, isa, cache) \
+    X(k, u, p, 2, isa, cache) X(k, u, p, 4, isa, cache) X(k, u, p, 16, isa, cache) X(k, u, p, 32, isa, cache)
+#define PLACE_ISAS(X, k, u, p, cache) \
+    PLACE_ALIGNS(X, k, u, p, rvc, cache) PLACE_ALIGNS(X, k, u, p, norvc, cache)
+// Kalt hat nur für Flash eine Bedeutung, IRAM läuft ohne Cache
+#define PLACE_VARIANTS(X, k, u) \
+    PLACE_ISAS(X, k, u, iram, warm) PLACE_ISAS(X, k, u, flash, warm) PLACE_ISAS(X, k, u, flash, cold)
+
+#define PLACE_ID(k, p, a, isa, cache)   k##_##p##_a##a##_##isa##_##cache
+
+#define CASE_ENUM(k, u, p, a, isa, cache)   PLACE_ID(k, p, a, isa, cache),
+#define CASE_ENUM_KERNEL(k, u)              PLACE_VARIANTS(CASE_ENUM, k, u)
+enum place_case_id { PLACE_KERNELS(CASE_ENUM_KERNEL) PLACE_CASE_COUNT };
+
+#define CASE_INIT(k, u, p, a, isa, cache) \
+    { #k, Placement::p, a, Isa::isa, Cache::cache, u, FLT_MAX },
+#define CASE_INIT_KERNEL(k, u)              PLACE_VARIANTS(CASE_INIT, k, u)
+static place_case_t s_cases[PLACE_CASE_COUNT] = { PLACE_KERNELS(CASE_INIT_KERNEL) };
+
+// ============ KERNEL ============
+/**
+ * @brief Invalidiert die Cache-Zeilen ab code (nur Flash-Adressen)
+ */
+static void place_invalidate(const void* code) {
+    uint32_t addr = (uint32_t)(uintptr_t)code & ~(uint32_t)(PLACE_LINE_BYTES - 1);
+    cache_hal_invalidate_addr(addr, PLACE_CODE_WINDOW);
+}
+
+// Prolog, Ausrichtung, Schleife. Ausgerichtet und aufgefüllt wird mit RVC
+// (2-Byte-Nops), damit jede Ausrichtung erreichbar ist; das Auffüllen auf
+// Align mod 32 läuft einmal pro Aufruf vor dem Schleifenkopf.
+#define PLACE_ASM(isa_option) \
+    __asm__ __volatile__ ( \
+        ".option push\n" ".option rvc\n" \
+        "mv a0, %[loops]\n" "mv t0, %[init]\n" \
+        ".balign 32\n" \
+        ".rept %[pad]\n c.nop\n.endr\n" \
+        isa_option \
+        "1:\n" \
+        ".rept %[reps]\n addi t0, t0, 1\n.endr\n" \
+        "addi a0, a0, -1\n" "bnez a0, 1b\n" \
+        "mv %[out], t0\n" \
+        ".option pop\n" \
+        : [out] "=r" (out) \
+        : [loops] "r" (loops), [init] "r" (0), [pad] "i" ((Align % 32) / 2), [reps] "i" (Unroll) \
+        : "a0", "t0", "memory")
+
+template <unsigned Unroll, unsigned Align, Isa I, Cache C>
+static inline __attribute__((always_inline))
+uint32_t place_body(const void* self, void* arg, uint32_t iterations, uint32_t* result) {
+    place_case_t* c = (place_case_t*)arg;
+    const uint32_t loops = iterations >= Unroll ? iterations / Unroll : 1;
+    uint32_t out;
+
+    if constexpr (C == Cache::cold) {
+        place_invalidate(self);
+    }
+    uint32_t start = get_cycle_count();
+    if constexpr (I == Isa::rvc) {
+        PLACE_ASM(".option rvc\n");
+    } else {
+        PLACE_ASM(".option norvc\n");
+    }
+    uint32_t end = get_cycle_count();
+
+    *result = out;
+    uint32_t cycles = timing_subtract_overhead(end - start, 0);
+    bench_track_min(&c->best, (float)cycles / (loops * Unroll));
+    return cycles;
+}
+
+template <unsigned Unroll, unsigned Align, Isa I, Cache C>
+static uint32_t IRAM_ATTR __attribute__((noinline)) place_iram(void* arg, uint32_t iterations, uint32_t* result) {
+    return place_body<Unroll, Align, I, C>((const void*)&place_iram<Unroll, Align, I, C>, arg, iterations, result);
+}
+
+template <unsigned Unroll, unsigned Align, Isa I, Cache C>
+static uint32_t __attribute__((noinline)) place_flash(void* arg, uint32_t iterations, uint32_t* result) {
+    return place_body<Unroll, Align, I, C>((const void*)&place_flash<Unroll, Align, I, C>, arg, iterations, result);
+}
+
+// ============ REGISTRIERUNG ============
+#define PLACE_OPS(u, cache)     ((Cache::cache == Cache::cold ? PLACE_COLD_LOOPS : PLACE_LOOPS) * (u))
+
+#define REGISTER_PLACED(k, u, p, a, isa, cache) \
+    BENCH_REGISTER(place_##k##_##p##_a##a##_##isa##_##cache, \
+                   "place." #k "." #p ".a" #a "." #isa "." #cache, "micro", \
+                   "placement," #p ",align" #a "," #isa "," #cache, PLACE_OPS(u, cache), u, \
+                   (place_##p<u, a, Isa::isa, Cache::cache>), &s_cases[PLACE_ID(k, p, a, isa, cache)])
+#define REGISTER_KERNEL(k, u)   PLACE_VARIANTS(REGISTER_PLACED, k, u)
+
+PLACE_KERNELS(REGISTER_KERNEL)
+
+// ============ AUSGABE ============
+static float place_best(const place_case_t* row, Placement placement, Cache cache) {
+    for (const place_case_t& c : s_cases) {
+        if (c.unroll == row->unroll && c.align == row->align && c.isa == row->isa &&
+            c.placement == placement && c.cache == cache) {
+            return c.best;
+        }
+    }
+    return FLT_MAX;
+}
+
+static void print_cell(float value) {
+    if (value < FLT_MAX) {
+        printf(" %10.3f", value);
+    } else {
+        printf(" %10s", "-");
+    }
+}
+
+/**
+ * @brief Gibt Zyklen pro Operation je Variante und den Gewinn durch IRAM aus
+ * Zeilen: Kernel/Ausrichtung/RVC, Spalten: IRAM, Flash warm, Flash kalt.
+ * Es zählt das Minimum über alle Samples; nicht gemessene Zellen bleiben "-".
+ */
+void place_bench_print_table(void) {
+    bool measured = false;
+    for (const place_case_t& c : s_cases) {
+        measured |= c.best < FLT_MAX;
+    }
+    if (!measured) {
+        return;
+    }
+
+    printf("\n=== CODE-PLATZIERUNG (Zyklen pro Operation, Minimum) ===\n");
+    printf("%-8s %5s %6s %10s %10s %10s %10s\n", "Kernel", "Ausr.", "ISA", "iram", "flash", "flash/kalt", "IRAM-Gew.");
+    for (const place_case_t& row : s_cases) {
+        if (row.placement != Placement::iram) {
+            continue;
+        }
+        float iram = place_best(&row, Placement::iram, Cache::warm);
+        float flash = place_best(&row, Placement::flash, Cache::warm);
+        float cold = place_best(&row, Placement::flash, Cache::cold);
+        printf("%-8s %5u %6s", row.kernel, (unsigned)row.align, row.isa == Isa::rvc ? "rvc" : "norvc");
+        print_cell(iram);
+        print_cell(flash);
+        print_cell(cold);
+        if (iram < FLT_MAX && flash < FLT_MAX && flash > 0.0f) {
+            printf(" %9.1f%%\n", 100.0f * (flash - iram) / flash);
+        } else {
+            printf(" %10s\n", "-");
+        }
+    }
+}
+
+#else
+
+void place_bench_print_table(void) {
+}
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef PLACE_BENCH_H
+#define PLACE_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Tabelle Platzierung x Ausrichtung x RVC der zuletzt gemessenen Varianten
+void place_bench_print_table(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,487 @@
+#include "pmu.h"
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+
+#if CONFIG_IDF_TARGET_LINUX
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#define PMU_HAVE_PERF       1
+#endif
+#endif
+
+// ============ KONFIGURATION ============
+#define PMU_MAX_COUNTERS        4
+#define PMU_CALIBRATION_RUNS    16      // Leere Messklammern pro Gruppe (Minimum zählt)
+
+static const char* const s_event_names[PMU_EV_COUNT] = {
+    [PMU_EV_CYCLES]       = "cycles",
+    [PMU_EV_INSTRET]      = "inst",
+    [PMU_EV_LD_HAZARD]    = "ld_hazard",
+    [PMU_EV_JMP_HAZARD]   = "jmp_hazard",
+    [PMU_EV_IDLE]         = "idle",
+    [PMU_EV_LOAD]         = "load",
+    [PMU_EV_STORE]        = "store",
+    [PMU_EV_JMP_UNCOND]   = "jmp_uncond",
+    [PMU_EV_BRANCH]       = "branch",
+    [PMU_EV_BRANCH_TAKEN] = "branch_taken",
+    [PMU_EV_INST_COMP]    = "inst_comp",
+    [PMU_EV_ICACHE_MISS]  = "icache_miss",
+};
+
+static const struct {
+    const char* name;
+    uint32_t events;
+} s_event_sets[] = {
+    { "ipc",    PMU_SET_IPC },
+    { "stalls", PMU_SET_STALLS },
+    { "mem",    PMU_SET_MEM },
+    { "branch", PMU_SET_BRANCH },
+    { "all",    PMU_SET_ALL },
+};
+
+#if !CONFIG_IDF_TARGET_LINUX
+// ============ BACKEND: ESP32-C6 ============
+// Ein Zähler (mpccr), Ereignisauswahl per Bitmaske in mpcer. Derselbe Zähler
+// liefert sonst get_cycle_count() - während eines Messfensters zählt er das
+// gewählte Ereignis, danach wird wieder CYCLE ausgewählt.
+#define PMU_CSR_MPCER       0x7e0
+#define PMU_CSR_MPCCR       0x7e2
+
+#define PMU_MPCER_CYCLE     (1u << 0)
+
+static const uint16_t s_mpcer_bits[PMU_EV_COUNT] = {
+    [PMU_EV_CYCLES]       = 1u << 0,
+    [PMU_EV_INSTRET]      = 1u << 1,
+    [PMU_EV_LD_HAZARD]    = 1u << 2,
+    [PMU_EV_JMP_HAZARD]   = 1u << 3,
+    [PMU_EV_IDLE]         = 1u << 4,
+    [PMU_EV_LOAD]         = 1u << 5,
+    [PMU_EV_STORE]        = 1u << 6,
+    [PMU_EV_JMP_UNCOND]   = 1u << 7,
+    [PMU_EV_BRANCH]       = 1u << 8,
+    [PMU_EV_BRANCH_TAKEN] = 1u << 9,
+    [PMU_EV_INST_COMP]    = 1u << 10,
+    [PMU_EV_ICACHE_MISS]  = 0,          // Nicht im Kern-PMU (nur über den Cache-Controller)
+};
+
+static uint32_t s_start;
+
+static bool backend_available(void) {
+    return true;
+}
+
+static uint32_t backend_counter_count(void) {
+    return 1;
+}
+
+static uint32_t backend_supported_events(void) {
+    return PMU_SET_ALL & ~PMU_EVENT_BIT(PMU_EV_ICACHE_MISS);
+}
+
+/**
+ * @brief Wählt das Ereignis aus und merkt sich den Zählerstand
+ * @param events Genau ein Ereignis
+ * @param count Anzahl der Ereignisse (muss 1 sein)
+ * @return false bei mehr Ereignissen als Zählern oder unbekanntem Ereignis
+ */
+static bool backend_start(const pmu_event_t* events, uint32_t count) {
+    if (count != 1 || events[0] >= PMU_EV_COUNT || s_mpcer_bits[events[0]] == 0) {
+        return false;
+    }
+    uint32_t select = s_mpcer_bits[events[0]];
+    __asm__ volatile("csrw %1, %2\n\t"
+                     "csrr %0, %3"
+                     : "=r"(s_start) : "i"(PMU_CSR_MPCER), "r"(select), "i"(PMU_CSR_MPCCR) : "memory");
+    return true;
+}
+
+/**
+ * @brief Liest den Zähler und stellt die Zyklenzählung wieder her
+ * @param counts Ergebnis (ein Wert)
+ */
+void pmu_stop(uint32_t* counts) {
+    uint32_t end;
+    __asm__ volatile("csrr %0, %1\n\t"
+                     "csrw %2, %3"
+                     : "=r"(end) : "i"(PMU_CSR_MPCCR), "i"(PMU_CSR_MPCER), "r"(PMU_MPCER_CYCLE) : "memory");
+    counts[0] = end - s_start;
+}
+
+#elif defined(PMU_HAVE_PERF)
+// ============ BACKEND: LINUX (perf_event_open) ============
+// Eine Gruppe pro Messfenster, nur der aufrufende Thread im User-Mode.
+// Ohne Berechtigung (perf_event_paranoid) oder Hardware-Zähler (VM) ist
+// das PMU nicht verfügbar und die Messung entfällt.
+typedef struct {
+    bool mapped;
+    uint32_t type;
+    uint64_t config;
+} perf_map_t;
+
+#define PERF_CACHE(cache, op, result) \
+    ((PERF_COUNT_HW_CACHE_##cache) | ((PERF_COUNT_HW_CACHE_OP_##op) << 8) | ((PERF_COUNT_HW_CACHE_RESULT_##result) << 16))
+
+static const perf_map_t s_perf_map[PMU_EV_COUNT] = {
+    [PMU_EV_CYCLES]       = { true, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    [PMU_EV_INSTRET]      = { true, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    [PMU_EV_LD_HAZARD]    = { true, PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND },
+    [PMU_EV_LOAD]         = { true, PERF_TYPE_HW_CACHE, PERF_CACHE(L1D, READ, ACCESS) },
+    [PMU_EV_STORE]        = { true, PERF_TYPE_HW_CACHE, PERF_CACHE(L1D, WRITE, ACCESS) },
+    [PMU_EV_BRANCH]       = { true, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS },
+    [PMU_EV_ICACHE_MISS]  = { true, PERF_TYPE_HW_CACHE, PERF_CACHE(L1I, READ, MISS) },
+    // JMP_HAZARD, IDLE, JMP_UNCOND, BRANCH_TAKEN, INST_COMP: keine generische
+    // Entsprechung in Zyklen bzw. Ereignissen gleicher Bedeutung
+};
+
+static int s_probed;
+static uint32_t s_supported;
+static int s_fds[PMU_MAX_COUNTERS];
+static uint32_t s_open;
+
+static int perf_open(pmu_event_t ev, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = s_perf_map[ev].type;
+    attr.config = s_perf_map[ev].config;
+    attr.disabled = group_fd < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+/**
+ * @brief Prüft einmalig, welche Ereignisse sich öffnen lassen
+ */
+static void perf_probe(void) {
+    if (s_probed) {
+        return;
+    }
+    s_probed = 1;
+    for (int ev = 0; ev < PMU_EV_COUNT; ev++) {
+        if (!s_perf_map[ev].mapped) {
+            continue;
+        }
+        int fd = perf_open((pmu_event_t)ev, -1);
+        if (fd >= 0) {
+            s_supported |= PMU_EVENT_BIT(ev);
+            close(fd);
+        }
+    }
+}
+
+static bool backend_available(void) {
+    perf_probe();
+    return s_supported != 0;
+}
+
+static uint32_t backend_counter_count(void) {
+    return backend_available() ? PMU_MAX_COUNTERS : 0;
+}
+
+static uint32_t backend_supported_events(void) {
+    perf_probe();
+    return s_supported;
+}
+
+static void perf_close(void) {
+    for (uint32_t i = 0; i < s_open; i++) {
+        close(s_fds[i]);
+    }
+    s_open = 0;
+}
+
+/**
+ * @brief Öffnet die Ereignisse als Gruppe und startet sie gemeinsam
+ * @param events Ereignisse (höchstens pmu_counter_count())
+ * @param count Anzahl der Ereignisse
+ * @return false wenn ein Ereignis nicht geöffnet werden konnte
+ */
+static bool backend_start(const pmu_event_t* events, uint32_t count) {
+    if (count == 0 || count > PMU_MAX_COUNTERS) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        int fd = perf_open(events[i], s_open ? s_fds[0] : -1);
+        if (fd < 0) {
+            perf_close();
+            return false;
+        }
+        s_fds[s_open++] = fd;
+    }
+    ioctl(s_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(s_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+/**
+ * @brief Stoppt die Gruppe und liest die Zählerstände
+ * @param counts Ergebnis in der Reihenfolge von pmu_start()
+ */
+void pmu_stop(uint32_t* counts) {
+    if (s_open == 0) {
+        return;
+    }
+    ioctl(s_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for (uint32_t i = 0; i < s_open; i++) {
+        uint64_t value = 0;
+        counts[i] = read(s_fds[i], &value, sizeof(value)) == sizeof(value) ? (uint32_t)value : 0;
+    }
+    perf_close();
+}
+
+#else
+// ============ BACKEND: KEIN PMU ============
+static bool backend_available(void) {
+    return false;
+}
+
+static uint32_t backend_counter_count(void) {
+    return 0;
+}
+
+static uint32_t backend_supported_events(void) {
+    return 0;
+}
+
+static bool backend_start(const pmu_event_t* events, uint32_t count) {
+    (void)events;
+    (void)count;
+    return false;
+}
+
+void pmu_stop(uint32_t* counts) {
+    (void)counts;
+}
+#endif
+
+// ============ VERFÜGBARKEIT ============
+static bool s_disabled;
+
+/**
+ * @brief Gibt das PMU frei (Standard) oder sperrt es
+ * Gesperrt verhält es sich wie ein Target ohne PMU: keine Zähler, keine
+ * Ereignisse, pmu_start() schlägt fehl.
+ */
+void pmu_enable(bool enable) {
+    s_disabled = !enable;
+}
+
+bool pmu_available(void) {
+    return !s_disabled && backend_available();
+}
+
+uint32_t pmu_counter_count(void) {
+    return pmu_available() ? backend_counter_count() : 0;
+}
+
+uint32_t pmu_supported_events(void) {
+    return pmu_available() ? backend_supported_events() : 0;
+}
+
+/**
+ * @brief Startet die Zählung (siehe Backend); false ohne verfügbares PMU
+ */
+bool pmu_start(const pmu_event_t* events, uint32_t count) {
+    return pmu_available() && backend_start(events, count);
+}
+
+// ============ NAMEN ============
+/**
+ * @brief Kurzname eines Ereignisses (wie in pmu_parse_events())
+ */
+const char* pmu_event_name(pmu_event_t ev) {
+    return ev < PMU_EV_COUNT ? s_event_names[ev] : "unknown";
+}
+
+/**
+ * @brief Wandelt eine Komma-getrennte Liste in eine Ereignismaske
+ * Erlaubt sind Ereignisnamen ("inst", "ld_hazard", ...) und Sätze
+ * ("ipc", "stalls", "mem", "branch", "all").
+ * @param list Liste (NULL oder "" = keine Ereignisse)
+ * @return Ereignismaske (PMU_EVENT_BIT), Unbekanntes wird gemeldet und ignoriert
+ */
+uint32_t pmu_parse_events(const char* list) {
+    uint32_t events = 0;
+    while (list != NULL && *list != '\0') {
+        const char* end = strchr(list, ',');
+        size_t len = end ? (size_t)(end - list) : strlen(list);
+        bool found = false;
+
+        for (size_t i = 0; i < sizeof(s_event_sets) / sizeof(s_event_sets[0]) && !found; i++) {
+            if (strlen(s_event_sets[i].name) == len && strncmp(s_event_sets[i].name, list, len) == 0) {
+                events |= s_event_sets[i].events;
+                found = true;
+            }
+        }
+        for (int ev = 0; ev < PMU_EV_COUNT && !found; ev++) {
+            if (strlen(s_event_names[ev]) == len && strncmp(s_event_names[ev], list, len) == 0) {
+                events |= PMU_EVENT_BIT(ev);
+                found = true;
+            }
+        }
+        if (!found && len > 0) {
+            printf("Unbekanntes PMU-Ereignis: %.*s\n", (int)len, list);
+        }
+        list = end ? end + 1 : list + len;
+    }
+    return events;
+}
+
+// ============ MULTIPLEXING ============
+/**
+ * @brief Misst eine Gruppe gleichzeitig zählbarer Ereignisse
+ * Der Overhead der Messklammer wird pro Gruppe als Minimum leerer Klammern
+ * bestimmt und von jedem Lauf abgezogen.
+ */
+static void measure_group(const pmu_event_t* group, uint32_t count, uint32_t reps,
+                          pmu_workload_fn fn, void* ctx, pmu_result_t* out) {
+    uint32_t overhead[PMU_MAX_COUNTERS];
+    uint32_t counts[PMU_MAX_COUNTERS];
+    uint64_t sums[PMU_MAX_COUNTERS] = { 0 };
+    uint32_t done = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        overhead[i] = UINT32_MAX;
+    }
+    for (int run = 0; run < PMU_CALIBRATION_RUNS; run++) {
+        if (!pmu_start(group, count)) {
+            return;
+        }
+        pmu_stop(counts);
+        for (uint32_t i = 0; i < count; i++) {
+            if (counts[i] < overhead[i]) {
+                overhead[i] = counts[i];
+            }
+        }
+    }
+
+    for (uint32_t rep = 0; rep < reps; rep++) {
+        if (!pmu_start(group, count)) {
+            break;
+        }
+        fn(ctx);
+        pmu_stop(counts);
+        for (uint32_t i = 0; i < count; i++) {
+            sums[i] += counts[i] > overhead[i] ? counts[i] - overhead[i] : 0;
+        }
+        done++;
+    }
+
+    for (uint32_t i = 0; done > 0 && i < count; i++) {
+        out->events |= PMU_EVENT_BIT(group[i]);
+        out->counts[group[i]] = (uint32_t)((sums[i] + done / 2) / done);
+        out->reps[group[i]] = (uint8_t)(done > UINT8_MAX ? UINT8_MAX : done);
+    }
+}
+
+/**
+ * @brief Teilt Ereignisse in Gruppen gleichzeitig zählbarer Ereignisse auf
+ * Reihenfolge wie pmu_event_t, alle Gruppen außer der letzten sind voll.
+ * @param events Ereignismaske
+ * @param slots Gleichzeitig nutzbare Zähler (pmu_counter_count())
+ * @param groups Ereignismaske pro Gruppe (Platz für PMU_EV_COUNT Gruppen)
+ * @return Anzahl der Gruppen, 0 ohne Zähler oder Ereignisse
+ */
+uint32_t pmu_split_groups(uint32_t events, uint32_t slots, uint32_t* groups) {
+    uint32_t count = 0;
+    uint32_t filled = 0;
+
+    if (slots == 0) {
+        return 0;
+    }
+    for (int ev = 0; ev < PMU_EV_COUNT; ev++) {
+        if (!(events & PMU_EVENT_BIT(ev))) {
+            continue;
+        }
+        if (filled == 0) {
+            groups[count++] = 0;
+        }
+        groups[count - 1] |= PMU_EVENT_BIT(ev);
+        if (++filled == slots) {
+            filled = 0;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Misst beliebig viele Ereignisse mit den vorhandenen Zählern
+ * Die Ereignisse werden in Gruppen zu pmu_counter_count() aufgeteilt, jede
+ * Gruppe misst reps Läufe der Last. Ereignisse verschiedener Gruppen stammen
+ * damit aus verschiedenen Läufen - Verhältnisse (IPC) sind nur bei
+ * stabiler Last aussagekräftig.
+ * @param events Ereignismaske (nicht unterstützte werden übergangen)
+ * @param reps Läufe pro Gruppe (>= 1)
+ * @param fn Last, wird (Gruppen x (reps + Kalibrierung)) mal aufgerufen
+ * @param ctx Argument für fn
+ * @param out Mittelwerte pro Lauf; out->events enthält die gemessenen Ereignisse
+ */
+void pmu_measure(uint32_t events, uint32_t reps, pmu_workload_fn fn, void* ctx, pmu_result_t* out) {
+    uint32_t groups[PMU_EV_COUNT];
+    pmu_event_t group[PMU_MAX_COUNTERS];
+    uint32_t slots = pmu_counter_count();
+
+    memset(out, 0, sizeof(*out));
+    if (slots > PMU_MAX_COUNTERS) {
+        slots = PMU_MAX_COUNTERS;
+    }
+    if (reps == 0) {
+        reps = 1;
+    }
+
+    uint32_t group_count = pmu_split_groups(events & pmu_supported_events(), slots, groups);
+    for (uint32_t g = 0; g < group_count; g++) {
+        uint32_t count = 0;
+        for (int ev = 0; ev < PMU_EV_COUNT; ev++) {
+            if (groups[g] & PMU_EVENT_BIT(ev)) {
+                group[count++] = (pmu_event_t)ev;
+            }
+        }
+        measure_group(group, count, reps, fn, ctx, out);
+    }
+}
+
+// ============ AUSGABE ============
+/**
+ * @brief Gibt Ereignisse pro Operation sowie IPC und Stall-Anteile aus
+ * @param name Testname
+ * @param iterations Operationen pro Lauf
+ * @param result Ergebnis von pmu_measure()
+ */
+void pmu_print(const char* name, uint32_t iterations, const pmu_result_t* result) {
+    if (result->events == 0) {
+        return;
+    }
+    double ops = iterations ? (double)iterations : 1.0;
+    double cycles = (double)result->counts[PMU_EV_CYCLES];
+    bool have_cycles = (result->events & PMU_EVENT_BIT(PMU_EV_CYCLES)) && cycles > 0;
+
+    printf("%s PMU pro Operation:", name);
+    for (int ev = 0; ev < PMU_EV_COUNT; ev++) {
+        if (result->events & PMU_EVENT_BIT(ev)) {
+            printf(" %s=%.3f", s_event_names[ev], result->counts[ev] / ops);
+        }
+    }
+    printf("\n");
+
+    if (!have_cycles) {
+        return;
+    }
+    printf("%s PMU:", name);
+    if (result->events & PMU_EVENT_BIT(PMU_EV_INSTRET)) {
+        printf(" IPC %.3f", result->counts[PMU_EV_INSTRET] / cycles);
+    }
+    static const pmu_event_t stalls[] = { PMU_EV_LD_HAZARD, PMU_EV_JMP_HAZARD, PMU_EV_IDLE };
+    for (size_t i = 0; i < sizeof(stalls) / sizeof(stalls[0]); i++) {
+        if (result->events & PMU_EVENT_BIT(stalls[i])) {
+            printf(" | %s %.1f%%", s_event_names[stalls[i]], 100.0 * result->counts[stalls[i]] / cycles);
+        }
+    }
+    printf("\n");
+}
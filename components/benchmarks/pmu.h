@@ -0,0 +1,71 @@
+#ifndef PMU_H
+#define PMU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Abstrakte Ereignisse. Target: Performance-Counter-CSRs des ESP32-C6
+// (mpcer/mpccr, ein Zähler). linux: perf_event_open, sonst nicht verfügbar.
+typedef enum {
+    PMU_EV_CYCLES = 0,
+    PMU_EV_INSTRET,         // Ausgeführte Instruktionen
+    PMU_EV_LD_HAZARD,       // Stalls durch Load-Abhängigkeiten
+    PMU_EV_JMP_HAZARD,      // Stalls durch Sprünge/Verzweigungen
+    PMU_EV_IDLE,            // Wartezyklen (z. B. Speicher, WFI)
+    PMU_EV_LOAD,
+    PMU_EV_STORE,
+    PMU_EV_JMP_UNCOND,
+    PMU_EV_BRANCH,
+    PMU_EV_BRANCH_TAKEN,
+    PMU_EV_INST_COMP,       // Komprimierte Instruktionen (RVC)
+    PMU_EV_ICACHE_MISS,     // Nur linux (ESP32-C6: nicht im Kern-PMU)
+    PMU_EV_COUNT
+} pmu_event_t;
+
+#define PMU_EVENT_BIT(ev)   (1u << (ev))
+
+// Vordefinierte Sätze
+#define PMU_SET_IPC         (PMU_EVENT_BIT(PMU_EV_CYCLES) | PMU_EVENT_BIT(PMU_EV_INSTRET))
+#define PMU_SET_STALLS      (PMU_SET_IPC | PMU_EVENT_BIT(PMU_EV_LD_HAZARD) | \
+                             PMU_EVENT_BIT(PMU_EV_JMP_HAZARD) | PMU_EVENT_BIT(PMU_EV_IDLE))
+#define PMU_SET_MEM         (PMU_SET_IPC | PMU_EVENT_BIT(PMU_EV_LOAD) | PMU_EVENT_BIT(PMU_EV_STORE) | \
+                             PMU_EVENT_BIT(PMU_EV_ICACHE_MISS))
+#define PMU_SET_BRANCH      (PMU_SET_IPC | PMU_EVENT_BIT(PMU_EV_JMP_UNCOND) | PMU_EVENT_BIT(PMU_EV_BRANCH) | \
+                             PMU_EVENT_BIT(PMU_EV_BRANCH_TAKEN))
+#define PMU_SET_ALL         ((1u << PMU_EV_COUNT) - 1)
+
+// Mittelwerte pro Sample, um den Overhead von pmu_start()/pmu_stop() bereinigt
+typedef struct {
+    uint32_t events;                // Tatsächlich gemessene Ereignisse
+    uint32_t counts[PMU_EV_COUNT];
+    uint8_t reps[PMU_EV_COUNT];     // Wiederholungen pro Ereignis
+} pmu_result_t;
+
+typedef void (*pmu_workload_fn)(void* ctx);
+
+// Verfügbarkeit und Namen
+void pmu_enable(bool enable);
+bool pmu_available(void);
+uint32_t pmu_counter_count(void);
+uint32_t pmu_supported_events(void);
+const char* pmu_event_name(pmu_event_t ev);
+uint32_t pmu_parse_events(const char* list);
+
+// Rohzugriff: bis zu pmu_counter_count() Ereignisse gleichzeitig
+bool pmu_start(const pmu_event_t* events, uint32_t count);
+void pmu_stop(uint32_t* counts);
+
+// Gemultiplexte Messung: Ereignisse in Gruppen zu pmu_counter_count(), je Gruppe reps Läufe
+uint32_t pmu_split_groups(uint32_t events, uint32_t slots, uint32_t* groups);
+void pmu_measure(uint32_t events, uint32_t reps, pmu_workload_fn fn, void* ctx, pmu_result_t* out);
+void pmu_print(const char* name, uint32_t iterations, const pmu_result_t* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,674 @@
+#include "result_log.h"
+
+#if CONFIG_BENCH_RESULT_LOG
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_err.h"
+#include "esp_partition.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include <unistd.h>
+#include "esp_private/partition_linux.h"
+#endif
+
+// ============ KONFIGURATION ============
+#define BATCH_BYTES         CONFIG_BENCH_RESULT_LOG_BATCH_BYTES
+#define STAGE_BYTES         512
+#define ENTRY_SIZE(len)     ((sizeof(result_log_entry_t) + (len) + 3u) & ~3u)
+#define ERASED_TYPE         0xFF
+#define SECTOR_NONE         UINT32_MAX
+
+// ============ ZUSTAND ============
+static const esp_partition_t* s_part;
+static uint32_t s_sector_size;
+static uint32_t s_sector_count;
+static uint32_t s_sector = SECTOR_NONE;     // Aktueller Schreibsektor
+static uint32_t s_write_off;                // Schreibposition im aktuellen Sektor
+static uint32_t s_seq;                      // Sequenz des aktuellen Sektors
+static uint16_t s_boot;                     // Aktuelle Sitzung
+static char s_build[RESULT_FRAME_MAX_TEXT + 1];
+
+// RAM-Puffer: Drain-Task hängt an, result_log_commit() leert (nach result_sink_flush()).
+// Die Sperre schützt den Puffer, falls der Drain-Task doch gleichzeitig anhängt.
+static SemaphoreHandle_t s_batch_lock;
+static StaticSemaphore_t s_batch_lock_buf;
+static uint8_t s_batch[BATCH_BYTES] __attribute__((aligned(4)));
+static size_t s_batch_len;
+static uint32_t s_batch_dropped;
+static uint32_t s_reported_batch_dropped;
+
+// Schreibseite (nur result_log_commit()): Zwischenpuffer für wenige große
+// Schreibvorgänge, im aktuellen Sektor bereits abgelegte Testnamen
+static uint8_t s_stage[STAGE_BYTES] __attribute__((aligned(4)));
+static size_t s_stage_len;
+static uint8_t s_named[RESULT_SINK_MAX_TESTS / 8];
+static bool s_boot_pending;                 // BOOT-Eintrag vor dem nächsten Eintrag
+
+// ============ PRÜFSUMMEN ============
+/**
+ * @brief CRC-16/CCITT (Polynom 0x1021), fortsetzbar
+ * @param crc Startwert (0xFFFF) bzw. Zwischenstand
+ */
+static uint16_t crc16(uint16_t crc, const void* data, size_t len) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)(bytes[i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t entry_crc(const result_log_entry_t* entry, const uint8_t* payload) {
+    return crc16(crc16(0xFFFF, entry, 2), payload, entry->len);
+}
+
+// ============ SEKTOREN ============
+/**
+ * @brief Liest einen Sektorkopf
+ * @return true wenn Magic und CRC stimmen
+ */
+static bool read_header(uint32_t sector, result_log_sector_t* hdr) {
+    if (esp_partition_read(s_part, sector * s_sector_size, hdr, sizeof(*hdr)) != ESP_OK) {
+        return false;
+    }
+    return hdr->magic == RESULT_LOG_SECTOR_MAGIC &&
+           hdr->crc == crc16(0xFFFF, hdr, offsetof(result_log_sector_t, crc));
+}
+
+/**
+ * @brief Sucht den Sektor mit der höchsten Sequenz
+ * @return Sektorindex oder SECTOR_NONE bei leerer Partition
+ */
+static uint32_t find_newest(result_log_sector_t* newest) {
+    uint32_t found = SECTOR_NONE;
+    result_log_sector_t hdr;
+    for (uint32_t i = 0; i < s_sector_count; i++) {
+        if (read_header(i, &hdr) && (found == SECTOR_NONE || (int32_t)(hdr.seq - newest->seq) > 0)) {
+            *newest = hdr;
+            found = i;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Läuft über die Einträge eines Sektors (Puffer mit Sektorgröße)
+ * Endet am gelöschten Bereich oder am ersten beschädigten Eintrag (z. B.
+ * Stromausfall während des Schreibens).
+ * @param torn Wird gesetzt, wenn ein beschädigter Eintrag gefunden wurde
+ * @return Position hinter dem letzten gültigen Eintrag
+ */
+static uint32_t scan_sector(uint8_t* buf, uint32_t sector, result_log_entry_fn fn, void* arg, bool* torn) {
+    uint32_t off = sizeof(result_log_sector_t);
+    *torn = false;
+
+    if (esp_partition_read(s_part, sector * s_sector_size, buf, s_sector_size) != ESP_OK) {
+        *torn = true;
+        return off;
+    }
+    while (off + sizeof(result_log_entry_t) <= s_sector_size) {
+        const result_log_entry_t* entry = (const result_log_entry_t*)&buf[off];
+        const uint8_t* payload = &buf[off + sizeof(*entry)];
+        if (entry->type == ERASED_TYPE) {
+            *torn = entry->len != 0xFF || entry->crc != 0xFFFF;
+            break;
+        }
+        if (off + ENTRY_SIZE(entry->len) > s_sector_size || entry->crc != entry_crc(entry, payload)) {
+            *torn = true;
+            break;
+        }
+        if (fn != NULL) {
+            fn(entry, payload, arg);
+        }
+        off += ENTRY_SIZE(entry->len);
+    }
+    return off;
+}
+
+/**
+ * @brief Löscht den nächsten Sektor (der älteste, sobald die Partition
+ * einmal umlaufen ist) und schreibt seinen Kopf
+ */
+static esp_err_t open_next_sector(void) {
+    uint32_t next = (s_sector == SECTOR_NONE) ? 0 : (s_sector + 1) % s_sector_count;
+    result_log_sector_t hdr;
+    uint32_t erase_count = read_header(next, &hdr) ? hdr.erase_count + 1 : 1;
+
+    esp_err_t err = esp_partition_erase_range(s_part, next * s_sector_size, s_sector_size);
+    if (err != ESP_OK) {
+        return err;
+    }
+    hdr.magic = RESULT_LOG_SECTOR_MAGIC;
+    hdr.seq = s_seq + 1;
+    hdr.erase_count = erase_count;
+    hdr.boot = s_boot;
+    hdr.crc = crc16(0xFFFF, &hdr, offsetof(result_log_sector_t, crc));
+    err = esp_partition_write(s_part, next * s_sector_size, &hdr, sizeof(hdr));
+    if (err != ESP_OK) {
+        return err;
+    }
+    s_sector = next;
+    s_seq = hdr.seq;
+    s_write_off = sizeof(hdr);
+    return ESP_OK;
+}
+
+// ============ RAM-PUFFER ============
+/**
+ * @brief Kodiert einen Eintrag (Kopf, Nutzdaten, Füllbytes)
+ * @param dst Ziel mit mindestens ENTRY_SIZE(len) Byte
+ * @return Größe des Eintrags
+ */
+static size_t encode_entry(uint8_t* dst, uint8_t type, const void* payload, size_t len) {
+    result_log_entry_t* entry = (result_log_entry_t*)dst;
+    uint8_t* data = &dst[sizeof(*entry)];
+    entry->type = type;
+    entry->len = (uint8_t)len;
+    memcpy(data, payload, len);
+    // Füllbytes bleiben gelöscht
+    memset(&data[len], 0xFF, ENTRY_SIZE(len) - sizeof(*entry) - len);
+    entry->crc = entry_crc(entry, data);
+    return ENTRY_SIZE(len);
+}
+
+/**
+ * @brief Hängt einen Eintrag an den RAM-Puffer an (kein Flashzugriff)
+ * Ist der Puffer voll, wird der Eintrag verworfen und gezählt.
+ */
+static void append(uint8_t type, const void* payload, size_t len) {
+    if (s_batch_lock == NULL) {
+        return;
+    }
+    xSemaphoreTake(s_batch_lock, portMAX_DELAY);
+    if (s_part == NULL) {
+        // Log deaktiviert
+    } else if (s_batch_len + ENTRY_SIZE(len) > BATCH_BYTES) {
+        s_batch_dropped++;
+    } else {
+        s_batch_len += encode_entry(&s_batch[s_batch_len], type, payload, len);
+    }
+    xSemaphoreGive(s_batch_lock);
+}
+
+void result_log_append_record(const result_record_t* rec) {
+    append(RESULT_FRAME_RECORD, rec, sizeof(*rec));
+}
+
+void result_log_append_pmu(const result_pmu_record_t* rec) {
+    append(RESULT_FRAME_PMU, rec, sizeof(*rec));
+}
+
+void result_log_append_dropped(uint32_t dropped) {
+    append(RESULT_FRAME_DROPPED, &dropped, sizeof(dropped));
+}
+
+// ============ FLASH ============
+/**
+ * @brief Schreibt den Zwischenpuffer an die Schreibposition
+ */
+static esp_err_t stage_flush(void) {
+    if (s_stage_len == 0) {
+        return ESP_OK;
+    }
+    esp_err_t err = esp_partition_write(s_part, s_sector * s_sector_size + s_write_off, s_stage, s_stage_len);
+    s_write_off += s_stage_len;
+    s_stage_len = 0;
+    return err;
+}
+
+/**
+ * @brief Legt einen Eintrag im Zwischenpuffer ab (Platz im Sektor geprüft)
+ */
+static esp_err_t stage_entry(uint8_t type, const void* payload, size_t len) {
+    esp_err_t err = ESP_OK;
+    if (s_stage_len + ENTRY_SIZE(len) > sizeof(s_stage)) {
+        err = stage_flush();
+    }
+    s_stage_len += encode_entry(&s_stage[s_stage_len], type, payload, len);
+    return err;
+}
+
+/**
+ * @brief Nutzdaten eines Namenseintrags (test_id + Name) bzw. BOOT-Eintrags
+ * @return Länge der Nutzdaten
+ */
+static size_t text_payload(uint8_t* payload, uint16_t id, const char* text) {
+    size_t text_len = strnlen(text, RESULT_FRAME_MAX_TEXT);
+    memcpy(payload, &id, 2);
+    memcpy(&payload[2], text, text_len);
+    return 2 + text_len;
+}
+
+/**
+ * @brief Schreibt einen Eintrag aus dem RAM-Puffer in den Flash
+ * Jeder Sektor ist für sich lesbar: er beginnt mit dem BOOT-Eintrag der
+ * Sitzung, und jeder Testname steht vor dem ersten Datensatz dieser ID im
+ * Sektor. Wird der älteste Sektor gelöscht, bleiben die übrigen dekodierbar.
+ */
+static esp_err_t commit_entry(const uint8_t* batch_entry) {
+    const result_log_entry_t* entry = (const result_log_entry_t*)batch_entry;
+    const uint8_t* data = &batch_entry[sizeof(*entry)];
+    uint8_t name_payload[RESULT_FRAME_MAX_PAYLOAD];
+    size_t name_len = 0;
+    uint16_t test_id = RESULT_SINK_INVALID_ID;
+    esp_err_t err = ESP_OK;
+
+    if ((entry->type == RESULT_FRAME_RECORD || entry->type == RESULT_FRAME_PMU) && entry->len >= 2) {
+        memcpy(&test_id, data, 2);
+    }
+    for (int attempt = 0; attempt < 2; attempt++) {
+        bool named = test_id >= RESULT_SINK_MAX_TESTS || (s_named[test_id / 8] & (1u << (test_id % 8)));
+        if (!named) {
+            name_len = text_payload(name_payload, test_id, result_sink_test_name(test_id));
+        }
+        size_t need = ENTRY_SIZE(entry->len) + (named ? 0 : ENTRY_SIZE(name_len)) +
+                      (s_boot_pending ? ENTRY_SIZE(2 + strlen(s_build)) : 0);
+        if (s_sector != SECTOR_NONE && s_write_off + s_stage_len + need <= s_sector_size) {
+            break;
+        }
+        // Neuer Sektor: Namen und Sitzung dort erneut ablegen
+        err = stage_flush();
+        if (err == ESP_OK) {
+            err = open_next_sector();
+        }
+        if (err != ESP_OK) {
+            return err;
+        }
+        memset(s_named, 0, sizeof(s_named));
+        s_boot_pending = true;
+    }
+
+    if (s_boot_pending) {
+        uint8_t boot_payload[RESULT_FRAME_MAX_PAYLOAD];
+        err = stage_entry(RESULT_FRAME_BOOT, boot_payload, text_payload(boot_payload, s_boot, s_build));
+        s_boot_pending = false;
+    }
+    if (err == ESP_OK && name_len > 0) {
+        err = stage_entry(RESULT_FRAME_TEST_NAME, name_payload, name_len);
+        s_named[test_id / 8] |= (uint8_t)(1u << (test_id % 8));
+    }
+    if (err == ESP_OK) {
+        err = stage_entry(entry->type, data, entry->len);
+    }
+    return err;
+}
+
+/**
+ * @brief Schreibt den RAM-Puffer in den Flash
+ * Nur nach result_sink_flush() aufrufen: der Drain-Task ist dann untätig und
+ * kein Messfenster offen. Löschen und Programmieren des Flash halten den
+ * Cache an und dürfen nie in eine Messung fallen.
+ * @return Anzahl geschriebener Datensätze
+ */
+size_t result_log_commit(void) {
+    size_t entries = 0;
+    size_t pos = 0;
+    esp_err_t err = ESP_OK;
+
+    if (s_part == NULL) {
+        return 0;
+    }
+    xSemaphoreTake(s_batch_lock, portMAX_DELAY);
+    if (s_batch_len == 0) {
+        xSemaphoreGive(s_batch_lock);
+        return 0;
+    }
+
+    TRACE_BEGIN("log.commit");
+    while (pos < s_batch_len && err == ESP_OK) {
+        err = commit_entry(&s_batch[pos]);
+        pos += ENTRY_SIZE(s_batch[pos + 1]);
+        entries++;
+    }
+    if (err == ESP_OK) {
+        err = stage_flush();
+    }
+    s_batch_len = 0;
+    if (err != ESP_OK) {
+        s_part = NULL;
+    }
+    TRACE_END("log.commit");
+    xSemaphoreGive(s_batch_lock);
+
+    if (err != ESP_OK) {
+        printf("❌ Ergebnislog: Flashzugriff fehlgeschlagen (%s), Log deaktiviert\n", esp_err_to_name(err));
+    }
+    if (s_batch_dropped != s_reported_batch_dropped) {
+        printf("⚠️  Ergebnislog: %" PRIu32 " Einträge verworfen (RAM-Puffer voll)\n", s_batch_dropped);
+        s_reported_batch_dropped = s_batch_dropped;
+    }
+    return entries;
+}
+
+// ============ INITIALISIERUNG ============
+#if CONFIG_IDF_TARGET_LINUX
+/**
+ * @brief Emuliertes Flash-Abbild zwischen Programmläufen erhalten
+ * Existiert das Abbild, wird es eingeblendet. Sonst legt die Emulation ein
+ * temporäres Abbild mit der Partitionstabelle des Builds an, das
+ * host_image_keep() an den konfigurierten Pfad verschiebt.
+ */
+static void host_image_prepare(void) {
+    esp_partition_file_mmap_ctrl_t* input = esp_partition_get_file_mmap_ctrl_input();
+    input->remove_dump = false;
+    if (access(CONFIG_BENCH_RESULT_LOG_HOST_IMAGE, F_OK) == 0) {
+        snprintf(input->flash_file_name, sizeof(input->flash_file_name), "%s",
+                 CONFIG_BENCH_RESULT_LOG_HOST_IMAGE);
+    }
+}
+
+static void host_image_keep(void) {
+    const esp_partition_file_mmap_ctrl_t* act = esp_partition_get_file_mmap_ctrl_act();
+    if (access(CONFIG_BENCH_RESULT_LOG_HOST_IMAGE, F_OK) != 0 &&
+        rename(act->flash_file_name, CONFIG_BENCH_RESULT_LOG_HOST_IMAGE) != 0) {
+        printf("ℹ️  Ergebnislog: Flash-Abbild bleibt in %s\n", act->flash_file_name);
+    }
+}
+#endif
+
+static void find_boot(const result_log_entry_t* entry, const uint8_t* payload, void* arg) {
+    uint16_t* boot = (uint16_t*)arg;
+    uint16_t value;
+    if (entry->type == RESULT_FRAME_BOOT && entry->len >= 2) {
+        memcpy(&value, payload, 2);
+        if ((int16_t)(value - *boot) > 0) {
+            *boot = value;
+        }
+    }
+}
+
+/**
+ * @brief Sucht die Partition, stellt die Schreibposition wieder her und
+ * beginnt eine neue Sitzung
+ * Gelesen werden nur die Sektorköpfe und der neueste Sektor. Endet dieser mit
+ * einem beschädigten Eintrag, wird beim nächsten Commit ein neuer Sektor
+ * begonnen.
+ * @param build Build-Kennung wie in der BUILD-Zeile
+ * @return true wenn das Log verfügbar ist
+ */
+bool result_log_init(const char* build) {
+    result_log_sector_t newest;
+    uint16_t last_boot = 0;
+
+    if (s_part != NULL) {
+        return true;
+    }
+#if CONFIG_IDF_TARGET_LINUX
+    host_image_prepare();
+#endif
+    s_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                      CONFIG_BENCH_RESULT_LOG_PARTITION);
+    if (s_part == NULL) {
+        printf("ℹ️  Ergebnislog: Partition \"%s\" fehlt (partitions.csv), Log deaktiviert\n",
+               CONFIG_BENCH_RESULT_LOG_PARTITION);
+        return false;
+    }
+#if CONFIG_IDF_TARGET_LINUX
+    host_image_keep();
+#endif
+    s_sector_size = s_part->erase_size;
+    s_sector_count = s_part->size / s_sector_size;
+    if (s_sector_count < 2) {
+        printf("❌ Ergebnislog: Partition \"%s\" braucht mindestens zwei Sektoren\n", s_part->label);
+        s_part = NULL;
+        return false;
+    }
+
+    uint32_t sector = find_newest(&newest);
+    if (sector != SECTOR_NONE) {
+        uint8_t* buf = malloc(s_sector_size);
+        bool torn = true;
+        last_boot = newest.boot;
+        if (buf != NULL) {
+            s_write_off = scan_sector(buf, sector, find_boot, &last_boot, &torn);
+            free(buf);
+        }
+        s_sector = sector;
+        s_seq = newest.seq;
+        if (torn) {
+            s_write_off = s_sector_size;
+        }
+    }
+
+    if (s_batch_lock == NULL) {
+        s_batch_lock = xSemaphoreCreateMutexStatic(&s_batch_lock_buf);
+    }
+    s_boot = (uint16_t)(last_boot + 1);
+    snprintf(s_build, sizeof(s_build), "%s", build);
+    if (strlen(build) > RESULT_FRAME_MAX_TEXT) {
+        printf("⚠️  Ergebnislog: Build-Kennung auf %d Zeichen gekürzt\n", RESULT_FRAME_MAX_TEXT);
+    }
+    s_boot_pending = true;
+    printf("Ergebnislog: Partition \"%s\", %" PRIu32 " KiB, Sitzung %u\n",
+           s_part->label, s_part->size / 1024, s_boot);
+    return true;
+}
+
+// ============ KONSOLE ============
+typedef struct {
+    uint32_t entries[8];        // nach Frame-Typ
+    uint32_t bytes;
+    uint32_t sectors;
+    uint32_t torn;
+    uint32_t sessions;
+    uint16_t first_boot;
+    uint16_t last_boot;
+} log_stats_t;
+
+static void count_entry(const result_log_entry_t* entry, const uint8_t* payload, void* arg) {
+    log_stats_t* stats = (log_stats_t*)arg;
+    uint16_t boot;
+    stats->entries[entry->type & 7]++;
+    if (entry->type == RESULT_FRAME_BOOT && entry->len >= 2) {
+        memcpy(&boot, payload, 2);
+        // Jeder Sektor wiederholt den BOOT-Eintrag seiner Sitzung
+        if (stats->sessions == 0) {
+            stats->first_boot = boot;
+        }
+        if (stats->sessions == 0 || boot != stats->last_boot) {
+            stats->sessions++;
+        }
+        stats->last_boot = boot;
+    }
+}
+
+/**
+ * @brief Läuft chronologisch über alle gültigen Sektoren
+ * Die Sektoren werden reihum beschrieben, der älteste folgt also auf den
+ * neuesten.
+ */
+static void walk_log(result_log_entry_fn fn, void* arg, log_stats_t* stats) {
+    result_log_sector_t hdr;
+    uint8_t* buf = malloc(s_sector_size);
+    if (buf == NULL) {
+        printf("❌ Ergebnislog: kein Speicher für den Sektorpuffer\n");
+        return;
+    }
+    uint32_t start = (s_sector == SECTOR_NONE) ? 0 : (s_sector + 1) % s_sector_count;
+    for (uint32_t k = 0; k < s_sector_count; k++) {
+        uint32_t sector = (start + k) % s_sector_count;
+        if (!read_header(sector, &hdr)) {
+            continue;
+        }
+        bool torn;
+        uint32_t end = scan_sector(buf, sector, fn, arg, &torn);
+        if (stats != NULL) {
+            stats->sectors++;
+            stats->bytes += end;
+            stats->torn += torn ? 1 : 0;
+        }
+    }
+    free(buf);
+}
+
+/**
+ * @brief Gibt Belegung, Löschzähler und Inhalt des Logs aus
+ */
+void result_log_status(void) {
+    log_stats_t stats = { 0 };
+    result_log_sector_t hdr;
+    uint32_t erase_min = UINT32_MAX;
+    uint32_t erase_max = 0;
+
+    if (s_part == NULL) {
+        printf("Ergebnislog nicht verfügbar\n");
+        return;
+    }
+    result_sink_flush();
+    result_log_commit();
+    for (uint32_t i = 0; i < s_sector_count; i++) {
+        uint32_t count = read_header(i, &hdr) ? hdr.erase_count : 0;
+        erase_min = count < erase_min ? count : erase_min;
+        erase_max = count > erase_max ? count : erase_max;
+    }
+    walk_log(count_entry, &stats, &stats);
+
+    printf("\n=== ERGEBNISLOG ===\n");
+    printf("Partition \"%s\" @0x%" PRIx32 ": %" PRIu32 " Sektoren à %" PRIu32 " Byte\n",
+           s_part->label, s_part->address, s_sector_count, s_sector_size);
+    printf("Belegt: %" PRIu32 " Sektoren, %" PRIu32 " Byte (%.1f%%), beschädigte Enden: %" PRIu32 "\n",
+           stats.sectors, stats.bytes, 100.0 * stats.bytes / s_part->size, stats.torn);
+    printf("Löschzähler pro Sektor: min %" PRIu32 ", max %" PRIu32 "\n", erase_min, erase_max);
+    if (stats.sessions > 0) {
+        printf("Sitzungen: %" PRIu32 " (%u bis %u, aktuell %u)\n",
+               stats.sessions, stats.first_boot, stats.last_boot, s_boot);
+    }
+    printf("Einträge: %" PRIu32 " Datensätze, %" PRIu32 " PMU, %" PRIu32 " Namen\n",
+           stats.entries[RESULT_FRAME_RECORD], stats.entries[RESULT_FRAME_PMU],
+           stats.entries[RESULT_FRAME_TEST_NAME]);
+    printf("RAM-Puffer: %u Byte, verworfen: %" PRIu32 "\n", BATCH_BYTES, s_batch_dropped);
+}
+
+typedef struct {
+    int32_t boot;               // Gewählte Sitzung, < 0 = alle
+    int32_t current;            // Zuletzt ausgegebene Sitzung, < 0 = keine
+    bool selected;
+    size_t count;
+} dump_ctx_t;
+
+static void dump_entry(const result_log_entry_t* entry, const uint8_t* payload, void* arg) {
+    dump_ctx_t* ctx = (dump_ctx_t*)arg;
+    if (entry->type == RESULT_FRAME_BOOT && entry->len >= 2) {
+        uint16_t boot;
+        memcpy(&boot, payload, 2);
+        ctx->selected = ctx->boot < 0 || ctx->boot == boot;
+        // Wiederholung am Sektoranfang nur einmal pro Sitzung ausgeben
+        if (!ctx->selected || ctx->current == boot) {
+            return;
+        }
+        ctx->current = boot;
+        // BUILD-Zeile wie beim Start, für scripts/data_processor.py
+        printf("BUILD,%.*s\n", entry->len - 2, (const char*)&payload[2]);
+    }
+    if (ctx->selected) {
+        result_sink_emit_frame(entry->type, payload, entry->len);
+        ctx->count++;
+    }
+}
+
+/**
+ * @brief Gibt das Log als Frames des Result-Sinks aus (scripts/serial_logger.py)
+ * Jede Sitzung beginnt mit ihrer BUILD-Zeile und einem BOOT-Frame. Testnamen
+ * stehen pro Sektor erneut im Log und werden mehrfach ausgegeben.
+ * @param boot Nur diese Sitzung, < 0 = alle
+ * @return Anzahl ausgegebener Einträge
+ */
+size_t result_log_dump(int32_t boot) {
+    dump_ctx_t ctx = { boot, -1, boot < 0, 0 };
+    if (s_part == NULL) {
+        printf("Ergebnislog nicht verfügbar\n");
+        return 0;
+    }
+    result_sink_flush();
+    result_log_commit();
+    walk_log(dump_entry, &ctx, NULL);
+    fflush(stdout);
+    printf("\nErgebnislog: %u Einträge ausgegeben\n", (unsigned)ctx.count);
+    return ctx.count;
+}
+
+typedef struct {
+    result_log_entry_fn fn;
+    void* arg;
+    size_t count;
+} foreach_ctx_t;
+
+static void foreach_entry(const result_log_entry_t* entry, const uint8_t* payload, void* arg) {
+    foreach_ctx_t* ctx = (foreach_ctx_t*)arg;
+    ctx->fn(entry, payload, ctx->arg);
+    ctx->count++;
+}
+
+/**
+ * @brief Läuft chronologisch über alle Einträge, nach einem Commit
+ * Wie result_log_dump(), aber an eine Funktion statt als Frames; BOOT- und
+ * Namenseinträge kommen wie im Flash pro Sektor wiederholt.
+ * @return Anzahl der Einträge
+ */
+size_t result_log_foreach(result_log_entry_fn fn, void* arg) {
+    foreach_ctx_t ctx = { fn, arg, 0 };
+    if (s_part == NULL) {
+        return 0;
+    }
+    result_sink_flush();
+    result_log_commit();
+    walk_log(foreach_entry, &ctx, NULL);
+    return ctx.count;
+}
+
+/**
+ * @brief Löscht die ganze Partition (Löschzähler beginnen von vorn)
+ */
+bool result_log_erase(void) {
+    if (s_part == NULL) {
+        printf("Ergebnislog nicht verfügbar\n");
+        return false;
+    }
+    result_sink_flush();
+    xSemaphoreTake(s_batch_lock, portMAX_DELAY);
+    esp_err_t err = esp_partition_erase_range(s_part, 0, s_sector_count * s_sector_size);
+    if (err == ESP_OK) {
+        s_sector = SECTOR_NONE;
+        s_seq = 0;
+        s_batch_len = 0;
+        s_boot_pending = true;
+    }
+    xSemaphoreGive(s_batch_lock);
+    if (err != ESP_OK) {
+        printf("❌ Ergebnislog: Löschen fehlgeschlagen (%s)\n", esp_err_to_name(err));
+        return false;
+    }
+    printf("Ergebnislog gelöscht\n");
+    return true;
+}
+
+/**
+ * @brief Schreibt den RAM-Puffer und schließt das Log
+ * Der Flash bleibt unverändert; result_log_init() stellt danach die
+ * Schreibposition wieder her und beginnt eine neue Sitzung wie nach einem
+ * Neustart.
+ */
+void result_log_close(void) {
+    if (s_part == NULL) {
+        return;
+    }
+    result_sink_flush();
+    result_log_commit();
+    xSemaphoreTake(s_batch_lock, portMAX_DELAY);
+    s_part = NULL;
+    s_sector = SECTOR_NONE;
+    s_seq = 0;
+    s_write_off = 0;
+    s_batch_len = 0;
+    s_stage_len = 0;
+    memset(s_named, 0, sizeof(s_named));
+    xSemaphoreGive(s_batch_lock);
+}
+
+#endif
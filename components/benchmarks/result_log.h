@@ -0,0 +1,94 @@
+#ifndef RESULT_LOG_H
+#define RESULT_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
+#include "result_sink.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Ergebnislog in einer eigenen Datenpartition (partitions.csv, "benchlog").
+// Ringförmiges Append-Log über die Sektoren der Partition: jeder Sektor
+// beginnt mit einem Kopf (Magic, Sektorsequenz, Löschzähler, Sitzung),
+// danach folgen Einträge [typ, länge, crc16, nutzdaten] auf 4 Byte
+// aufgefüllt. Die Typen
+// entsprechen den Frame-Typen des Result-Sinks, ein Eintrag ist ein Frame
+// ohne COBS. Ist die Partition voll, wird der älteste Sektor gelöscht, jeder
+// Sektor wird also pro Umlauf genau einmal gelöscht. Jeder Sektor beginnt mit
+// dem BOOT-Eintrag seiner Sitzung und enthält die Namen seiner Tests, er
+// bleibt damit auch ohne die älteren Sektoren dekodierbar.
+//
+// Einträge landen zunächst im RAM (Drain-Task); in den Flash geschrieben wird
+// nur in result_log_commit() nach result_sink_flush(), also nie innerhalb
+// eines Messfensters.
+
+#define RESULT_LOG_SECTOR_MAGIC     0x31474C42u     // "BLG1"
+
+// Sektorkopf (16 Byte)
+typedef struct __attribute__((packed)) {
+    uint32_t magic;         // RESULT_LOG_SECTOR_MAGIC
+    uint32_t seq;           // Fortlaufend über alle Sektoren, höchste = neuester
+    uint32_t erase_count;   // Löschvorgänge dieses Sektors
+    uint16_t boot;          // Sitzung beim Anlegen des Sektors
+    uint16_t crc;           // CRC-16 über die ersten 14 Byte
+} result_log_sector_t;
+
+_Static_assert(sizeof(result_log_sector_t) == 16, "result_log_sector_t muss 16 Byte groß sein");
+
+// Eintragskopf (4 Byte), typ 0xFF = gelöschter Flash (Ende der Daten)
+typedef struct __attribute__((packed)) {
+    uint8_t type;           // RESULT_FRAME_*
+    uint8_t len;            // Länge der Nutzdaten
+    uint16_t crc;           // CRC-16 über typ, länge und nutzdaten
+} result_log_entry_t;
+
+_Static_assert(sizeof(result_log_entry_t) == 4, "result_log_entry_t muss 4 Byte groß sein");
+
+#if CONFIG_BENCH_RESULT_LOG
+
+/**
+ * @brief Sucht die Partition, stellt die Schreibposition wieder her und
+ * beginnt eine neue Sitzung (RESULT_FRAME_BOOT mit der Build-Kennung vor
+ * ihrem ersten Eintrag)
+ * @param build Build-Kennung wie in der BUILD-Zeile (Version,Git,Konfiguration)
+ * @return true wenn das Log verfügbar ist
+ */
+bool result_log_init(const char* build);
+
+// Drain-Task: nur RAM, kein Flashzugriff
+void result_log_append_record(const result_record_t* rec);
+void result_log_append_pmu(const result_pmu_record_t* rec);
+void result_log_append_dropped(uint32_t dropped);
+
+// Schreibt den RAM-Puffer in den Flash; nur nach result_sink_flush() aufrufen
+size_t result_log_commit(void);
+
+// Konsole: Zustand, Ausgabe als Frames (scripts/serial_logger.py), Löschen
+void result_log_status(void);
+size_t result_log_dump(int32_t boot);
+bool result_log_erase(void);
+
+// Auswertung ohne Konsole (Host-Tests): Einträge chronologisch, Neustart
+typedef void (*result_log_entry_fn)(const result_log_entry_t* entry, const uint8_t* payload, void* arg);
+size_t result_log_foreach(result_log_entry_fn fn, void* arg);
+void result_log_close(void);
+
+#else
+
+static inline bool result_log_init(const char* build) { (void)build; return false; }
+static inline void result_log_append_record(const result_record_t* rec) { (void)rec; }
+static inline void result_log_append_pmu(const result_pmu_record_t* rec) { (void)rec; }
+static inline void result_log_append_dropped(uint32_t dropped) { (void)dropped; }
+static inline size_t result_log_commit(void) { return 0; }
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
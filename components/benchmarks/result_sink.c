@@ -0,0 +1,384 @@
+#include "result_sink.h"
+#include "result_log.h"
+#include "measurement_utils.h"
+#include "pmu.h"
+#include "trace.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <inttypes.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#if CONFIG_ESP_CONSOLE_UART
+#include "driver/uart_vfs.h"
+#endif
+#if CONFIG_ESP_CONSOLE_USB_SERIAL_JTAG_ENABLED
+#include "driver/usb_serial_jtag_vfs.h"
+#endif
+
+// ============ KONFIGURATION ============
+#define RING_RECORDS        CONFIG_BENCH_RESULT_RING_RECORDS
+#define RING_MASK           (RING_RECORDS - 1)
+#define MAX_FRAME_RAW       (2 + RESULT_FRAME_MAX_PAYLOAD + 1)      // magic + typ + nutzdaten + crc
+#define MAX_FRAME_ENCODED   (MAX_FRAME_RAW + MAX_FRAME_RAW / 254 + 3) // COBS + zwei Begrenzer
+#define DRAIN_TASK_STACK    4096
+
+#if CONFIG_LIBC_STDOUT_LINE_ENDING_CR
+#define CONSOLE_LINE_ENDINGS ESP_LINE_ENDINGS_CR
+#elif CONFIG_LIBC_STDOUT_LINE_ENDING_LF
+#define CONSOLE_LINE_ENDINGS ESP_LINE_ENDINGS_LF
+#else
+#define CONSOLE_LINE_ENDINGS ESP_LINE_ENDINGS_CRLF
+#endif
+
+_Static_assert((RING_RECORDS & RING_MASK) == 0, "Ringgröße muss eine Zweierpotenz sein");
+
+// ============ ZUSTAND ============
+// Single-Producer (Messtask) / Single-Consumer (Drain-Task)
+static result_record_t s_ring[RING_RECORDS];
+static _Atomic uint32_t s_head;             // nur Producer schreibt
+static _Atomic uint32_t s_tail;             // nur Consumer schreibt
+static _Atomic uint32_t s_dropped;
+static uint16_t s_seq;                      // nur Producer
+
+static const char* s_test_names[RESULT_SINK_MAX_TESTS];
+static _Atomic uint16_t s_test_count;
+static uint8_t s_announced[RESULT_SINK_MAX_TESTS / 8];   // nur Consumer
+static uint32_t s_reported_dropped;                      // nur Consumer
+static bool s_tests_overflow;                            // Überlauf der Namenstabelle gemeldet
+static TaskHandle_t s_drain_task;
+
+// ============ FRAMING ============
+/**
+ * @brief CRC-8 (Polynom 0x07) über einen Puffer
+ */
+static uint8_t crc8(const uint8_t* data, size_t len) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Consistent Overhead Byte Stuffing - entfernt alle Nullbytes
+ * @param src Rohdaten
+ * @param len Länge der Rohdaten
+ * @param dst Zielpuffer (mindestens len + len / 254 + 1 Byte)
+ * @return Länge der kodierten Daten (ohne Begrenzer)
+ */
+size_t cobs_encode(const uint8_t* src, size_t len, uint8_t* dst) {
+    size_t out = 1;
+    size_t code_pos = 0;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (src[i] == 0) {
+            dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+            continue;
+        }
+        dst[out++] = src[i];
+        if (++code == 0xFF) {
+            dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        }
+    }
+    dst[code_pos] = code;
+    return out;
+}
+
+/**
+ * @brief Schaltet die Zeilenende-Umsetzung der Konsole für Binärframes ab
+ * Bei CONFIG_LIBC_STDOUT_LINE_ENDING_CRLF setzt der VFS-Treiber vor jedes
+ * 0x0A ein 0x0D; in einem Frame bricht das die CRC, und der Decoder hält den
+ * Frame für Text. raw = false stellt die konfigurierte Umsetzung wieder her.
+ */
+static void console_raw(bool raw) {
+    // Gepufferte Ausgabe noch mit der bisherigen Umsetzung schreiben
+    fflush(stdout);
+#if CONFIG_ESP_CONSOLE_UART
+    uart_vfs_dev_port_set_tx_line_endings(CONFIG_ESP_CONSOLE_UART_NUM,
+                                          raw ? ESP_LINE_ENDINGS_LF : CONSOLE_LINE_ENDINGS);
+#endif
+#if CONFIG_ESP_CONSOLE_USB_SERIAL_JTAG_ENABLED
+    usb_serial_jtag_vfs_set_tx_line_endings(raw ? ESP_LINE_ENDINGS_LF : CONSOLE_LINE_ENDINGS);
+#endif
+    (void)raw;
+}
+
+/**
+ * @brief Schreibt einen COBS-gerahmten Frame auf die Konsole
+ * @param type Frame-Typ (RESULT_FRAME_*)
+ * @param payload Nutzdaten
+ * @param len Länge der Nutzdaten
+ */
+static void emit_frame(uint8_t type, const void* payload, size_t len) {
+    uint8_t raw[MAX_FRAME_RAW];
+    uint8_t encoded[MAX_FRAME_ENCODED];
+
+    raw[0] = RESULT_FRAME_MAGIC;
+    raw[1] = type;
+    memcpy(&raw[2], payload, len);
+    raw[2 + len] = crc8(raw, 2 + len);
+
+    // Führender Begrenzer trennt den Frame von eventueller Textausgabe
+    encoded[0] = 0;
+    size_t n = cobs_encode(raw, 3 + len, &encoded[1]);
+    encoded[1 + n] = 0;
+    fwrite(encoded, 1, n + 2, stdout);
+}
+
+/**
+ * @brief Schreibt einen Frame auch bei CSV-Ausgabe (z. B. Inhalt des Ergebnislogs)
+ * @param type Frame-Typ (RESULT_FRAME_*)
+ * @param payload Nutzdaten (längere als RESULT_FRAME_MAX_PAYLOAD werden gekürzt)
+ * @param len Länge der Nutzdaten
+ */
+void result_sink_emit_frame(uint8_t type, const void* payload, size_t len) {
+    if (len > RESULT_FRAME_MAX_PAYLOAD) {
+        printf("⚠️  result_sink: Frame-Typ 0x%02x mit %u Byte auf %u Byte gekürzt\n",
+               type, (unsigned)len, (unsigned)RESULT_FRAME_MAX_PAYLOAD);
+        len = RESULT_FRAME_MAX_PAYLOAD;
+    }
+#if CONFIG_BENCH_OUTPUT_CSV
+    // Textausgabe behält ihre Zeilenenden, nur der Frame geht unverändert raus
+    console_raw(true);
+    emit_frame(type, payload, len);
+    console_raw(false);
+#else
+    emit_frame(type, payload, len);
+#endif
+}
+
+// ============ AUSGABE ============
+#if CONFIG_BENCH_OUTPUT_CSV
+static void emit_record(const result_record_t* rec) {
+    static int header_written;
+    if (!header_written) {
+        printf("seq,test_name,iterations,total_cycles,cycles_per_op,time_per_op_us,result_value,cpu_freq_mhz\n");
+        header_written = 1;
+    }
+    double cycles_per_op = rec->iterations ? (double)rec->cycles / rec->iterations : 0.0;
+    double time_per_op = rec->iterations ? cycles_to_us(rec->cycles) / rec->iterations : 0.0;
+    printf("%u,%s,%" PRIu32 ",%" PRIu32 ",%.3f,%.6f,%" PRIu32 ",%" PRIu32 "\n",
+           rec->seq, result_sink_test_name(rec->test_id), rec->iterations, rec->cycles,
+           cycles_per_op, time_per_op, rec->checksum, get_cpu_freq_mhz());
+}
+
+static void emit_dropped(uint32_t dropped) {
+    printf("# result_sink: %" PRIu32 " Datensaetze verworfen\n", dropped);
+}
+
+static void emit_pmu(const result_pmu_record_t* rec) {
+    printf("pmu,%s,%s,%u,%" PRIu32 ",%" PRIu32 "\n", result_sink_test_name(rec->test_id),
+           pmu_event_name((pmu_event_t)rec->event), rec->reps, rec->iterations, rec->count);
+}
+#else
+/**
+ * @brief Kündigt den Testnamen vor dem ersten Frame dieser ID an
+ */
+static void announce_test(uint16_t test_id) {
+    if (test_id < RESULT_SINK_MAX_TESTS &&
+        !(s_announced[test_id / 8] & (1u << (test_id % 8)))) {
+        uint8_t payload[RESULT_FRAME_MAX_PAYLOAD];
+        const char* name = result_sink_test_name(test_id);
+        size_t name_len = strnlen(name, RESULT_FRAME_MAX_TEXT);
+        memcpy(payload, &test_id, 2);
+        memcpy(&payload[2], name, name_len);
+        emit_frame(RESULT_FRAME_TEST_NAME, payload, 2 + name_len);
+        s_announced[test_id / 8] |= (uint8_t)(1u << (test_id % 8));
+    }
+}
+
+static void emit_record(const result_record_t* rec) {
+    announce_test(rec->test_id);
+    emit_frame(RESULT_FRAME_RECORD, rec, sizeof(*rec));
+}
+
+static void emit_dropped(uint32_t dropped) {
+    emit_frame(RESULT_FRAME_DROPPED, &dropped, sizeof(dropped));
+}
+
+static void emit_pmu(const result_pmu_record_t* rec) {
+    announce_test(rec->test_id);
+    emit_frame(RESULT_FRAME_PMU, rec, sizeof(*rec));
+}
+#endif
+
+// ============ RINGPUFFER ============
+/**
+ * @brief Legt einen Datensatz im Ringpuffer ab (lock-free, nicht blockierend)
+ * Ist der Puffer voll, wird der Datensatz verworfen und gezählt.
+ * @param test_id ID aus result_sink_register_test()
+ * @param iterations Anzahl gemessener Operationen
+ * @param cycles Overhead-bereinigte Zyklen
+ * @param checksum Ergebniswert des Kernels
+ */
+void result_sink_push(uint16_t test_id, uint32_t iterations, uint32_t cycles, uint32_t checksum) {
+    if (test_id == RESULT_SINK_INVALID_ID) {
+        return;
+    }
+    uint32_t head = atomic_load_explicit(&s_head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&s_tail, memory_order_acquire);
+    uint16_t seq = s_seq++;
+
+    if (head - tail >= RING_RECORDS) {
+        atomic_fetch_add_explicit(&s_dropped, 1, memory_order_relaxed);
+        TRACE_INSTANT("sink.drop", test_id);
+        return;
+    }
+
+    result_record_t* rec = &s_ring[head & RING_MASK];
+    rec->test_id = test_id;
+    rec->seq = seq;
+    rec->iterations = iterations;
+    rec->cycles = cycles;
+    rec->checksum = checksum;
+    atomic_store_explicit(&s_head, head + 1, memory_order_release);
+}
+
+/**
+ * @brief Meldet neu verworfene Datensätze (Frame und Ergebnislog)
+ */
+static void report_dropped(void) {
+    uint32_t dropped = atomic_load_explicit(&s_dropped, memory_order_relaxed);
+    if (dropped != s_reported_dropped) {
+        emit_dropped(dropped);
+        result_log_append_dropped(dropped);
+        s_reported_dropped = dropped;
+        fflush(stdout);
+    }
+}
+
+/**
+ * @brief Gibt alle anstehenden Datensätze aus
+ * @return Anzahl ausgegebener Datensätze
+ */
+size_t result_sink_drain(void) {
+    uint32_t tail = atomic_load_explicit(&s_tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&s_head, memory_order_acquire);
+    size_t count = 0;
+
+    if (tail != head) {
+        TRACE_BEGIN("sink.drain");
+    }
+    while (tail != head) {
+        emit_record(&s_ring[tail & RING_MASK]);
+        result_log_append_record(&s_ring[tail & RING_MASK]);
+        if (tail + 1 == head) {
+            // Vor dem letzten s_tail-Update: nach result_sink_flush() ist auch
+            // die DROPPED-Meldung im Ergebnislog
+            report_dropped();
+        }
+        atomic_store_explicit(&s_tail, ++tail, memory_order_release);
+        count++;
+    }
+    if (count > 0) {
+        TRACE_END("sink.drain");
+        fflush(stdout);
+    } else {
+        report_dropped();
+    }
+    return count;
+}
+
+/**
+ * @brief Gibt einen PMU-Datensatz aus (am Ringpuffer vorbei)
+ * Nur nach result_sink_flush() aufrufen: der Drain-Task ist dann untätig und
+ * Ankündigung und Ausgabe kommen sich nicht in die Quere.
+ * @param rec Zählerstand eines Ereignisses
+ */
+void result_sink_emit_pmu(const result_pmu_record_t* rec) {
+    emit_pmu(rec);
+    result_log_append_pmu(rec);
+    fflush(stdout);
+}
+
+/**
+ * @brief Anzahl der wegen vollem Puffer verworfenen Datensätze
+ */
+uint32_t result_sink_dropped(void) {
+    return atomic_load_explicit(&s_dropped, memory_order_relaxed);
+}
+
+// ============ TESTNAMEN ============
+/**
+ * @brief Vergibt eine ID für einen Testnamen (idempotent)
+ * @param name Testname (muss dauerhaft gültig bleiben)
+ * @return Test-ID oder RESULT_SINK_INVALID_ID wenn die Tabelle voll ist (einmal gemeldet)
+ */
+uint16_t result_sink_register_test(const char* name) {
+    uint16_t count = atomic_load_explicit(&s_test_count, memory_order_acquire);
+    for (uint16_t i = 0; i < count; i++) {
+        if (strcmp(s_test_names[i], name) == 0) {
+            return i;
+        }
+    }
+    if (count >= RESULT_SINK_MAX_TESTS) {
+        if (!s_tests_overflow) {
+            printf("⚠️  result_sink: mehr als %d Tests, weitere ohne Datensätze (RESULT_SINK_MAX_TESTS)\n",
+                   RESULT_SINK_MAX_TESTS);
+            s_tests_overflow = true;
+        }
+        return RESULT_SINK_INVALID_ID;
+    }
+    s_test_names[count] = name;
+    atomic_store_explicit(&s_test_count, (uint16_t)(count + 1), memory_order_release);
+    return count;
+}
+
+/**
+ * @brief Liefert den Namen zu einer Test-ID
+ */
+const char* result_sink_test_name(uint16_t test_id) {
+    if (test_id >= atomic_load_explicit(&s_test_count, memory_order_acquire)) {
+        return "unknown";
+    }
+    return s_test_names[test_id];
+}
+
+// ============ DRAIN-TASK ============
+/**
+ * @brief Niedrig priorisierter Task, der den Ringpuffer auf die Konsole leert
+ * Läuft mit Idle-Priorität und damit nur, wenn der Messtask blockiert.
+ */
+static void result_sink_task(void* arg) {
+    (void)arg;
+    while (1) {
+        result_sink_drain();
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_BENCH_RESULT_DRAIN_PERIOD_MS));
+    }
+}
+
+/**
+ * @brief Startet den Drain-Task (einmalig)
+ */
+void result_sink_init(void) {
+    if (s_drain_task != NULL) {
+        return;
+    }
+#if !CONFIG_BENCH_OUTPUT_CSV
+    // Binärausgabe: Frames dürfen 0x0A enthalten, Text endet danach nur mit LF
+    console_raw(true);
+#endif
+    xTaskCreate(result_sink_task, "result_sink", DRAIN_TASK_STACK, NULL,
+                tskIDLE_PRIORITY, &s_drain_task);
+}
+
+/**
+ * @brief Wartet, bis der Drain-Task alle Datensätze ausgegeben hat
+ */
+void result_sink_flush(void) {
+    while (atomic_load_explicit(&s_tail, memory_order_acquire) !=
+           atomic_load_explicit(&s_head, memory_order_acquire)) {
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_BENCH_RESULT_DRAIN_PERIOD_MS));
+    }
+}
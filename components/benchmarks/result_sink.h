@@ -0,0 +1,66 @@
+#ifndef RESULT_SINK_H
+#define RESULT_SINK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Binärer Ergebnisdatensatz (16 Byte, little-endian, Layout = scripts/serial_logger.py)
+typedef struct __attribute__((packed)) {
+    uint16_t test_id;       // ID aus result_sink_register_test()
+    uint16_t seq;           // Laufende Nummer (Lückenerkennung auf dem Host)
+    uint32_t iterations;    // Anzahl gemessener Operationen
+    uint32_t cycles;        // Overhead-bereinigte Zyklen
+    uint32_t checksum;      // Ergebniswert des Kernels (Verifikation)
+} result_record_t;
+
+_Static_assert(sizeof(result_record_t) == 16, "result_record_t muss 16 Byte groß sein");
+
+// PMU-Zählerstand eines Tests (12 Byte), Mittelwert pro Lauf über reps Läufe
+typedef struct __attribute__((packed)) {
+    uint16_t test_id;
+    uint8_t event;          // pmu_event_t
+    uint8_t reps;           // Läufe, über die gemittelt wurde
+    uint32_t iterations;    // Operationen pro Lauf
+    uint32_t count;         // Overhead-bereinigter Zählerstand pro Lauf
+} result_pmu_record_t;
+
+_Static_assert(sizeof(result_pmu_record_t) == 12, "result_pmu_record_t muss 12 Byte groß sein");
+
+// Frame-Typen im COBS-Rahmen: [magic, typ, nutzdaten..., crc8]
+#define RESULT_FRAME_MAGIC      0xB5
+#define RESULT_FRAME_RECORD     0x01    // nutzdaten = result_record_t
+#define RESULT_FRAME_TEST_NAME  0x02    // nutzdaten = test_id (u16) + Name (ohne Terminator)
+#define RESULT_FRAME_DROPPED    0x03    // nutzdaten = verworfene Datensätze gesamt (u32)
+#define RESULT_FRAME_PMU        0x04    // nutzdaten = result_pmu_record_t
+#define RESULT_FRAME_BOOT       0x05    // nutzdaten = Sitzung (u16) + Build-Kennung (nur Ergebnislog)
+
+// Größte Nutzdaten: test_id bzw. Sitzung (u16) + Text; längere Texte werden gekürzt
+#define RESULT_FRAME_MAX_TEXT       64
+#define RESULT_FRAME_MAX_PAYLOAD    (2 + RESULT_FRAME_MAX_TEXT)
+
+#define RESULT_SINK_MAX_TESTS   512
+#define RESULT_SINK_INVALID_ID  0xFFFF  // Tabelle voll, Datensätze dieser Tests werden verworfen
+
+// Initialisierung / Drain-Task
+void result_sink_init(void);
+void result_sink_flush(void);
+
+// Testnamen (einmalig, außerhalb des Messpfads)
+uint16_t result_sink_register_test(const char* name);
+const char* result_sink_test_name(uint16_t test_id);
+
+// Messpfad: nicht blockierend, kein printf
+void result_sink_push(uint16_t test_id, uint32_t iterations, uint32_t cycles, uint32_t checksum);
+uint32_t result_sink_dropped(void);
+
+// PMU-Ergebnisse: direkt ausgegeben, nur nach result_sink_flush() aufrufen
+void result_sink_emit_pmu(const result_pmu_record_t* rec);
+
+// Einzelner Frame unabhängig vom Ausgabeformat (Ausgabe des Ergebnislogs)
+void result_sink_emit_frame(uint8_t type, const void* payload, size_t len);
+
+// Verarbeitung (Drain-Task, auch für Host-Tests direkt aufrufbar)
+size_t result_sink_drain(void);
+size_t cobs_encode(const uint8_t* src, size_t len, uint8_t* dst);
+
+#endif
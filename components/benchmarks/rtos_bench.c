@@ -0,0 +1,391 @@
+// FreeRTOS-Primitive: Ping-Pong-Latenz und Durchsatz
+//
+// Jeder Fall hat einen Partner-Task, der beim ersten Sample angelegt wird und
+// danach blockiert wartet. Während eines Samples läuft der messende Task auf
+// RTOS_BENCH_PRIO, der Partner je nach Fall darüber (Übergabe verdrängt sofort),
+// gleichauf (yield) oder darunter (Mutex-Halter, Prioritätsvererbung).
+//   .lat - eine Runde pro Sample (Verteilung über die Samples)
+//   .thr - RTOS_BURST_ROUNDS Runden pro Sample, Zyklen pro Runde
+// Eine Runde ist Hin- und Rückweg, also zwei Kontextwechsel.
+
+#include "bench_registry.h"
+#include "measurement_utils.h"
+#include "result_sink.h"
+#include <stdio.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_attr.h"
+#include "driver/gptimer.h"
+#endif
+
+// ============ KONFIGURATION ============
+// Unter den ESP-IDF-Systemtasks (esp_timer MAX-3, Event-Loop MAX-5, TCP/IP
+// MAX-7), damit weder der Messer noch seine Partner (±1) eine Priorität teilen
+#define RTOS_BENCH_PRIO         (configMAX_PRIORITIES - 10)
+#define RTOS_PARTNER_STACK      3072
+#define RTOS_BURST_ROUNDS       64
+#define RTOS_MAX_MSG            128
+#define RTOS_COUNTING_MAX       16
+
+#define ISR_TIMER_HZ            1000000     // 1 µs Auflösung
+#define ISR_ALARM_TICKS         20          // Alarm 20 µs nach Start, bei .thr Periode
+
+typedef enum {
+    PRIM_NOTIFY,
+    PRIM_QUEUE,
+    PRIM_BINARY_SEM,
+    PRIM_COUNTING_SEM,
+    PRIM_MUTEX,
+    PRIM_YIELD,
+    PRIM_ISR,
+} rtos_prim_t;
+
+typedef struct {
+    const char* name;
+    rtos_prim_t prim;
+    uint32_t msg_size;              // Nur Queue
+    TaskHandle_t partner;
+    TaskHandle_t requester;         // Messender Task des laufenden Samples
+    QueueHandle_t request;          // Queue bzw. Semaphore Hinweg / Mutex
+    QueueHandle_t response;         // Queue bzw. Semaphore Rückweg
+    volatile uint32_t value;        // Mutex: geerbte Priorität, Yield: aktiv
+} rtos_case_t;
+
+// ============ PARTNER-TASK ============
+/**
+ * @brief Gegenstelle aller Ping-Pong-Fälle (ein Task pro Fall)
+ */
+static void partner_task(void* arg) {
+    rtos_case_t* c = arg;
+    uint8_t msg[RTOS_MAX_MSG];
+
+    for (;;) {
+        switch (c->prim) {
+        case PRIM_NOTIFY:
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            xTaskNotifyGive(c->requester);
+            break;
+        case PRIM_QUEUE:
+            xQueueReceive(c->request, msg, portMAX_DELAY);
+            xQueueSend(c->response, msg, portMAX_DELAY);
+            break;
+        case PRIM_BINARY_SEM:
+        case PRIM_COUNTING_SEM:
+            xSemaphoreTake(c->request, portMAX_DELAY);
+            xSemaphoreGive(c->response);
+            break;
+        case PRIM_MUTEX:
+            // Niedrige Priorität: Mutex nehmen, Messer wecken (verdrängt sofort),
+            // mit geerbter Priorität weiterlaufen und freigeben
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            xSemaphoreTake(c->request, portMAX_DELAY);
+            xTaskNotifyGive(c->requester);
+            c->value = uxTaskPriorityGet(NULL);
+            xSemaphoreGive(c->request);
+            break;
+        case PRIM_YIELD:
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            while (c->value) {
+                taskYIELD();
+            }
+            break;
+        default:
+            vTaskSuspend(NULL);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Legt Primitive und Partner-Task beim ersten Sample an
+ * @return false, wenn Speicher fehlt
+ */
+static bool rtos_prepare(rtos_case_t* c) {
+    if (c->partner != NULL) {
+        return true;
+    }
+
+    UBaseType_t partner_prio = RTOS_BENCH_PRIO + 1;
+    switch (c->prim) {
+    case PRIM_QUEUE:
+        c->request = xQueueCreate(1, c->msg_size);
+        c->response = xQueueCreate(1, c->msg_size);
+        break;
+    case PRIM_BINARY_SEM:
+        c->request = xSemaphoreCreateBinary();
+        c->response = xSemaphoreCreateBinary();
+        break;
+    case PRIM_COUNTING_SEM:
+        c->request = xSemaphoreCreateCounting(RTOS_COUNTING_MAX, 0);
+        c->response = xSemaphoreCreateCounting(RTOS_COUNTING_MAX, 0);
+        break;
+    case PRIM_MUTEX:
+        c->request = xSemaphoreCreateMutex();
+        c->response = c->request;
+        partner_prio = RTOS_BENCH_PRIO - 1;
+        break;
+    case PRIM_YIELD:
+        partner_prio = RTOS_BENCH_PRIO;
+        break;
+    default:
+        break;
+    }
+    if ((c->prim == PRIM_QUEUE || c->prim == PRIM_BINARY_SEM || c->prim == PRIM_COUNTING_SEM ||
+         c->prim == PRIM_MUTEX) && (c->request == NULL || c->response == NULL)) {
+        printf("RTOS-Benchmark %s: Primitive nicht verfügbar\n", c->name);
+        return false;
+    }
+
+    c->requester = xTaskGetCurrentTaskHandle();
+    if (xTaskCreate(partner_task, c->name, RTOS_PARTNER_STACK, c, partner_prio, &c->partner) != pdPASS) {
+        printf("RTOS-Benchmark %s: Partner-Task nicht verfügbar\n", c->name);
+        c->partner = NULL;
+        return false;
+    }
+    return true;
+}
+
+// ============ RUNDEN ============
+/**
+ * @brief Misst rounds Ping-Pong-Runden in einer Messklammer
+ * Mutex: nur die blockierende Übernahme ist im Messfenster, der Aufbau
+ * (Partner nimmt den Mutex) liegt davor.
+ * @return Bereinigte Zyklen über alle Runden
+ */
+static uint32_t run_rounds(rtos_case_t* c, uint32_t rounds, uint32_t* result) {
+    uint8_t msg[RTOS_MAX_MSG] = { 0 };
+    uint32_t start, end, cycles = 0;
+
+    switch (c->prim) {
+    case PRIM_NOTIFY:
+        start = get_cycle_count();
+        for (uint32_t i = 0; i < rounds; i++) {
+            xTaskNotifyGive(c->partner);
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+        end = get_cycle_count();
+        cycles = timing_subtract_overhead(end - start, 0);
+        *result = rounds;
+        break;
+
+    case PRIM_QUEUE:
+        start = get_cycle_count();
+        for (uint32_t i = 0; i < rounds; i++) {
+            msg[0] = (uint8_t)i;
+            xQueueSend(c->request, msg, portMAX_DELAY);
+            xQueueReceive(c->response, msg, portMAX_DELAY);
+        }
+        end = get_cycle_count();
+        cycles = timing_subtract_overhead(end - start, 0);
+        *result = msg[0];
+        break;
+
+    case PRIM_BINARY_SEM:
+    case PRIM_COUNTING_SEM:
+        start = get_cycle_count();
+        for (uint32_t i = 0; i < rounds; i++) {
+            xSemaphoreGive(c->request);
+            xSemaphoreTake(c->response, portMAX_DELAY);
+        }
+        end = get_cycle_count();
+        cycles = timing_subtract_overhead(end - start, 0);
+        *result = rounds;
+        break;
+
+    case PRIM_MUTEX:
+        for (uint32_t i = 0; i < rounds; i++) {
+            xTaskNotifyGive(c->partner);
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);    // Partner hält jetzt den Mutex
+            start = get_cycle_count();
+            xSemaphoreTake(c->request, portMAX_DELAY);
+            end = get_cycle_count();
+            xSemaphoreGive(c->request);
+            cycles += timing_subtract_overhead(end - start, 0);
+        }
+        // Vom Partner gesehene Priorität: RTOS_BENCH_PRIO bei wirksamer Vererbung
+        *result = c->value;
+        break;
+
+    case PRIM_YIELD:
+        c->value = 1;
+        xTaskNotifyGive(c->partner);                    // Gleiche Priorität: nur bereit
+        start = get_cycle_count();
+        for (uint32_t i = 0; i < rounds; i++) {
+            taskYIELD();
+        }
+        end = get_cycle_count();
+        c->value = 0;
+        taskYIELD();                                    // Partner blockiert wieder
+        cycles = timing_subtract_overhead(end - start, 0);
+        *result = rounds;
+        break;
+
+    default:
+        *result = 0;
+        break;
+    }
+    return cycles;
+}
+
+// ============ ISR -> TASK (nur Target) ============
+#if !CONFIG_IDF_TARGET_LINUX
+static gptimer_handle_t s_isr_timer;
+static volatile uint32_t s_isr_cycles;
+static TaskHandle_t s_isr_waiter;
+
+/**
+ * @brief Alarm-Callback: Zeitstempel beim Eintritt, dann Task wecken
+ */
+static bool IRAM_ATTR isr_alarm(gptimer_handle_t timer, const gptimer_alarm_event_data_t* edata, void* ctx) {
+    s_isr_cycles = get_cycle_count();
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(s_isr_waiter, &woken);
+    return woken == pdTRUE;
+}
+
+static bool isr_prepare(void) {
+    if (s_isr_timer != NULL) {
+        return true;
+    }
+    gptimer_config_t timer_config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = ISR_TIMER_HZ,
+    };
+    gptimer_event_callbacks_t cbs = {
+        .on_alarm = isr_alarm,
+    };
+    if (gptimer_new_timer(&timer_config, &s_isr_timer) != ESP_OK) {
+        printf("RTOS-Benchmark isr: kein GPTimer verfügbar\n");
+        s_isr_timer = NULL;
+        return false;
+    }
+    ESP_ERROR_CHECK(gptimer_register_event_callbacks(s_isr_timer, &cbs, NULL));
+    ESP_ERROR_CHECK(gptimer_enable(s_isr_timer));
+    return true;
+}
+
+/**
+ * @brief Misst ISR-Eintritt bis Fortsetzung des geweckten Tasks
+ * Einmal-Alarm pro Runde, der Timer läuft nur während der Runde. Vor jeder
+ * Runde wird der Result-Sink geleert, damit der Drain-Task nicht im
+ * Wartefenster läuft (Ausgabe, Ergebnislog).
+ */
+static uint32_t bench_isr(void* arg, uint32_t iterations, uint32_t* result) {
+    gptimer_alarm_config_t alarm = {
+        .alarm_count = ISR_ALARM_TICKS,
+    };
+    uint32_t cycles = 0;
+
+    *result = 0;
+    if (!isr_prepare()) {
+        return 0;
+    }
+
+    UBaseType_t base_prio = uxTaskPriorityGet(NULL);
+    vTaskPrioritySet(NULL, RTOS_BENCH_PRIO);
+    s_isr_waiter = xTaskGetCurrentTaskHandle();
+    for (uint32_t i = 0; i < iterations; i++) {
+        result_sink_flush();
+        gptimer_set_raw_count(s_isr_timer, 0);
+        gptimer_set_alarm_action(s_isr_timer, &alarm);
+        gptimer_start(s_isr_timer);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint32_t end = get_cycle_count();
+        gptimer_stop(s_isr_timer);
+        cycles += timing_subtract_overhead(end - s_isr_cycles, 0);
+    }
+    vTaskPrioritySet(NULL, base_prio);
+
+    *result = iterations;
+    return cycles;
+}
+
+/**
+ * @brief Misst ISR-Eintritt bis Fortsetzung über periodische Alarme
+ * Der Timer läuft mit Auto-Reload durch, zwischen zwei Ereignissen wird
+ * nichts neu gestellt oder geleert: der Task kehrt direkt ins Warten zurück.
+ * Zählt ulTaskNotifyTake mehrere Ereignisse (Task nicht rechtzeitig wach),
+ * gehört der Zeitstempel zum letzten: gewertet wird nur dieses eine.
+ */
+static uint32_t bench_isr_burst(void* arg, uint32_t iterations, uint32_t* result) {
+    gptimer_alarm_config_t alarm = {
+        .alarm_count = ISR_ALARM_TICKS,
+        .reload_count = 0,
+        .flags.auto_reload_on_alarm = true,
+    };
+    uint32_t cycles = 0;
+
+    *result = 0;
+    if (!isr_prepare()) {
+        return 0;
+    }
+
+    UBaseType_t base_prio = uxTaskPriorityGet(NULL);
+    vTaskPrioritySet(NULL, RTOS_BENCH_PRIO);
+    s_isr_waiter = xTaskGetCurrentTaskHandle();
+    result_sink_flush();
+    gptimer_set_raw_count(s_isr_timer, 0);
+    gptimer_set_alarm_action(s_isr_timer, &alarm);
+    gptimer_start(s_isr_timer);
+    for (uint32_t i = 0; i < iterations; i++) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint32_t end = get_cycle_count();
+        cycles += timing_subtract_overhead(end - s_isr_cycles, 0);
+    }
+    gptimer_stop(s_isr_timer);
+    ulTaskNotifyTake(pdTRUE, 0);    // Alarm zwischen letztem Take und Stopp
+    vTaskPrioritySet(NULL, base_prio);
+
+    *result = iterations;
+    return cycles;
+}
+
+BENCH_REGISTER(isr_notify_lat, "isr.notify.lat", "interrupt", "rtos,isr,latency", 1, 1, bench_isr, NULL)
+BENCH_REGISTER(isr_notify_thr, "isr.notify.thr", "interrupt", "rtos,isr,throughput",
+               RTOS_BURST_ROUNDS, 1, bench_isr_burst, NULL)
+#endif
+
+// ============ REGISTRIERUNG ============
+/**
+ * @brief Ein Sample: Priorität anheben, Runden messen, Priorität zurücksetzen
+ */
+static uint32_t bench_rtos(void* arg, uint32_t iterations, uint32_t* result) {
+    rtos_case_t* c = arg;
+    *result = 0;
+    if (!rtos_prepare(c)) {
+        return 0;
+    }
+
+    UBaseType_t base_prio = uxTaskPriorityGet(NULL);
+    vTaskPrioritySet(NULL, RTOS_BENCH_PRIO);
+    c->requester = xTaskGetCurrentTaskHandle();
+    uint32_t cycles = run_rounds(c, iterations, result);
+    vTaskPrioritySet(NULL, base_prio);
+    return cycles;
+}
+
+#define RTOS_CASE_LIST(X) \
+    /* ident      name             primitive           msg   gruppe */ \
+    X(notify,     "notify",        PRIM_NOTIFY,        0,    notify) \
+    X(queue4,     "queue.4",       PRIM_QUEUE,         4,    queue) \
+    X(queue32,    "queue.32",      PRIM_QUEUE,         32,   queue) \
+    X(queue128,   "queue.128",     PRIM_QUEUE,         128,  queue) \
+    X(sem_bin,    "sem.binary",    PRIM_BINARY_SEM,    0,    semaphore) \
+    X(sem_count,  "sem.counting",  PRIM_COUNTING_SEM,  0,    semaphore) \
+    X(mutex,      "mutex.pi",      PRIM_MUTEX,         0,    mutex) \
+    X(yield,      "yield",         PRIM_YIELD,         0,    yield)
+
+#define DEFINE_RTOS_CASE(ident, name, prim, msg, group) \
+    static rtos_case_t s_rtos_##ident = { name, prim, msg, NULL, NULL, NULL, NULL, 0 }; \
+    BENCH_REGISTER(rtos_##ident##_lat, name ".lat", "interrupt", "rtos," #group ",latency", \
+                   1, 1, bench_rtos, &s_rtos_##ident) \
+    BENCH_REGISTER(rtos_##ident##_thr, name ".thr", "interrupt", "rtos," #group ",throughput", \
+                   RTOS_BURST_ROUNDS, 1, bench_rtos, &s_rtos_##ident)
+
+RTOS_CASE_LIST(DEFINE_RTOS_CASE)
@@ -0,0 +1,210 @@
+#include "trace.h"
+
+#if CONFIG_BENCH_TRACE
+
+#include "bench_registry.h"
+#include "measurement_utils.h"
+#include "result_sink.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <inttypes.h>
+#if !CONFIG_IDF_TARGET_LINUX
+#include "soc/soc_caps.h"
+#endif
+
+// ============ KONFIGURATION ============
+#define TRACE_EVENTS        CONFIG_BENCH_TRACE_EVENTS
+#define TRACE_MASK          (TRACE_EVENTS - 1)
+// Feste Aufrufstellen plus eine Stelle je Benchmark (TRACE_BEGIN_DYN)
+#define TRACE_MAX_SITES     (RESULT_SINK_MAX_TESTS + 64)
+#define TRACE_BENCH_EVENTS  256
+
+#if CONFIG_IDF_TARGET_LINUX
+#define TRACE_CORES         1
+#else
+#define TRACE_CORES         SOC_CPU_CORES_NUM
+#endif
+
+_Static_assert((TRACE_EVENTS & TRACE_MASK) == 0, "Trace-Puffer muss eine Zweierpotenz sein");
+_Static_assert(sizeof(trace_event_t) == 16, "Trace-Ereignis muss 16 Byte groß sein");
+
+// Ein Ring pro Kern: Schreiber (Tasks und ISRs dieses Kerns) reservieren
+// ihren Platz per atomarem Inkrement, ältere Ereignisse werden überschrieben
+typedef struct {
+    _Atomic uint32_t head;
+    trace_event_t events[TRACE_EVENTS];
+} trace_ring_t;
+
+// ============ ZUSTAND ============
+static trace_ring_t s_rings[TRACE_CORES];
+static const char* s_site_names[TRACE_MAX_SITES];
+static _Atomic uint32_t s_site_count;
+
+static inline uint8_t trace_core(void) {
+#if TRACE_CORES > 1
+    return (uint8_t)esp_cpu_get_core_id();
+#else
+    return 0;
+#endif
+}
+
+// ============ NAMENSTABELLE ============
+/**
+ * @brief Vergibt eine neue ID für einen Namen
+ * @return ID oder TRACE_ID_NONE, wenn die Tabelle voll ist
+ */
+static uint16_t site_alloc(const char* name) {
+    uint32_t id = atomic_fetch_add_explicit(&s_site_count, 1, memory_order_relaxed);
+    if (id >= TRACE_MAX_SITES) {
+        atomic_store_explicit(&s_site_count, TRACE_MAX_SITES, memory_order_relaxed);
+        return TRACE_ID_NONE;
+    }
+    s_site_names[id] = name;
+    return (uint16_t)id;
+}
+
+/**
+ * @brief ID zu einem Laufzeit-Namen (Vergleich per Zeiger, dann per Inhalt)
+ * Lineare Suche - nur außerhalb von Messfenstern verwenden.
+ */
+uint16_t trace_intern(const char* name) {
+    uint32_t count = atomic_load_explicit(&s_site_count, memory_order_acquire);
+    for (uint32_t i = 0; i < count && i < TRACE_MAX_SITES; i++) {
+        if (s_site_names[i] == name || (s_site_names[i] != NULL && strcmp(s_site_names[i], name) == 0)) {
+            return (uint16_t)i;
+        }
+    }
+    return site_alloc(name);
+}
+
+/**
+ * @brief ID einer Aufrufstelle, beim ersten Ereignis per Name vergeben
+ * BEGIN und END mit gleichem Namen teilen sich so eine ID. Verlieren zwei
+ * Schreiber das Rennen um dieselbe Stelle, bleibt höchstens ein
+ * gleichnamiger Eintrag ungenutzt - harmlos.
+ */
+static inline uint16_t site_id(trace_site_t* site) {
+    uint32_t id = __atomic_load_n(&site->id, __ATOMIC_ACQUIRE);
+    if (id != TRACE_ID_NONE) {
+        return (uint16_t)id;
+    }
+    uint32_t fresh = trace_intern(site->name);
+    uint32_t expected = TRACE_ID_NONE;
+    if (!__atomic_compare_exchange_n(&site->id, &expected, fresh, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return (uint16_t)expected;
+    }
+    return (uint16_t)fresh;
+}
+
+// ============ SCHREIBEN ============
+static inline void ring_write(trace_ring_t* ring, uint16_t id, uint8_t type, uint8_t core, uint32_t arg) {
+    uint32_t slot = atomic_fetch_add_explicit(&ring->head, 1, memory_order_relaxed) & TRACE_MASK;
+    trace_event_t* ev = &ring->events[slot];
+    ev->cycles = get_cycle_count();
+    ev->time_us = (uint32_t)get_time_us();
+    ev->site = id;
+    ev->type = type;
+    ev->core = core;
+    ev->arg = arg;
+}
+
+/**
+ * @brief Schreibt ein Ereignis einer statischen Aufrufstelle (TRACE_BEGIN/END/INSTANT)
+ * noinline: trace.emit misst denselben Aufruf wie die Makros in anderen Dateien.
+ */
+__attribute__((noinline)) void trace_emit(trace_site_t* site, uint8_t type, uint32_t arg) {
+    uint8_t core = trace_core();
+    ring_write(&s_rings[core], site_id(site), type, core, arg);
+}
+
+/**
+ * @brief Schreibt ein Ereignis mit bereits bekannter ID
+ */
+__attribute__((noinline)) void trace_emit_id(uint16_t id, uint8_t type, uint32_t arg) {
+    uint8_t core = trace_core();
+    ring_write(&s_rings[core], id, type, core, arg);
+}
+
+/**
+ * @brief Verwirft alle Ereignisse (Namenstabelle bleibt erhalten)
+ */
+void trace_clear(void) {
+    for (int core = 0; core < TRACE_CORES; core++) {
+        atomic_store_explicit(&s_rings[core].head, 0, memory_order_release);
+    }
+}
+
+// ============ AUSGABE ============
+/**
+ * @brief Gibt Namenstabelle und Ereignisse als Textzeilen aus
+ * Format (scripts/trace_to_json.py):
+ *   TRACE_START,<cpu_mhz>,<cores>
+ *   TRACE_SITE,<id>,<name>
+ *   TRACE_EV,<core>,<typ>,<zyklen>,<us>,<id>,<arg>   (pro Kern chronologisch)
+ *   TRACE_STOP,<überschriebene ereignisse>
+ * Während der Ausgabe sollte nicht getract werden.
+ */
+void trace_dump(void) {
+    uint32_t overwritten = 0;
+
+    printf("TRACE_START,%" PRIu32 ",%d\n", get_cpu_freq_mhz(), TRACE_CORES);
+    uint32_t sites = atomic_load_explicit(&s_site_count, memory_order_acquire);
+    for (uint32_t i = 0; i < sites && i < TRACE_MAX_SITES; i++) {
+        printf("TRACE_SITE,%u,%s\n", (unsigned)i, s_site_names[i] ? s_site_names[i] : "?");
+    }
+    for (int core = 0; core < TRACE_CORES; core++) {
+        uint32_t head = atomic_load_explicit(&s_rings[core].head, memory_order_acquire);
+        uint32_t count = head < TRACE_EVENTS ? head : TRACE_EVENTS;
+        overwritten += head - count;
+        for (uint32_t i = head - count; i != head; i++) {
+            const trace_event_t* ev = &s_rings[core].events[i & TRACE_MASK];
+            printf("TRACE_EV,%u,%c,%" PRIu32 ",%" PRIu32 ",%u,%" PRIu32 "\n",
+                   (unsigned)ev->core, ev->type, ev->cycles, ev->time_us, (unsigned)ev->site, ev->arg);
+        }
+    }
+    printf("TRACE_STOP,%" PRIu32 "\n", overwritten);
+}
+
+// ============ EIGENMESSUNG ============
+// Beide Messungen schreiben in den Ring des laufenden Kerns und überschreiben
+// dort ältere Ereignisse; im Dump erscheinen sie als "trace.bench".
+
+/**
+ * @brief Kosten von trace_emit() (TRACE_BEGIN/END/INSTANT)
+ */
+static uint32_t bench_trace_emit(void* arg, uint32_t iterations, uint32_t* result) {
+    static trace_site_t site = { "trace.bench", TRACE_ID_NONE };
+    (void)arg;
+
+    uint32_t start = get_cycle_count();
+    for (uint32_t i = 0; i < iterations; i++) {
+        trace_emit(&site, TRACE_EV_INSTANT, i);
+    }
+    uint32_t end = get_cycle_count();
+
+    *result = iterations;
+    return timing_subtract_overhead(end - start, iterations);
+}
+
+/**
+ * @brief Kosten von trace_emit_id() (TRACE_BEGIN_DYN/END_DYN ohne Namenssuche)
+ */
+static uint32_t bench_trace_emit_id(void* arg, uint32_t iterations, uint32_t* result) {
+    uint16_t id = trace_intern("trace.bench");
+    (void)arg;
+
+    uint32_t start = get_cycle_count();
+    for (uint32_t i = 0; i < iterations; i++) {
+        trace_emit_id(id, TRACE_EV_INSTANT, i);
+    }
+    uint32_t end = get_cycle_count();
+
+    *result = iterations;
+    return timing_subtract_overhead(end - start, iterations);
+}
+
+BENCH_REGISTER(trace_emit, "trace.emit", "micro", "trace,overhead", TRACE_BENCH_EVENTS, 1, bench_trace_emit, NULL)
+BENCH_REGISTER(trace_emit_id, "trace.emit_id", "micro", "trace,overhead", TRACE_BENCH_EVENTS, 1, bench_trace_emit_id, NULL)
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Ereignistypen (Chrome-Trace "ph")
+#define TRACE_EV_BEGIN      'B'
+#define TRACE_EV_END        'E'
+#define TRACE_EV_INSTANT    'i'
+
+#define TRACE_ID_NONE       0xFFFF
+
+// 16-Byte-Ereignis, auf Target und linux identisch (keine Zeiger).
+// Der Zykluszähler läuft nach Sekunden über, die Mikrosekunden erst nach
+// 71 Minuten - der Konverter entfaltet die Zyklen anhand der Mikrosekunden.
+typedef struct {
+    uint32_t cycles;        // Zykluszähler (fein)
+    uint32_t time_us;       // get_time_us(), untere 32 Bit (grob)
+    uint16_t site;          // Index in die Namenstabelle
+    uint8_t type;           // TRACE_EV_*
+    uint8_t core;
+    uint32_t arg;           // Frei, z. B. Test-ID oder Anzahl
+} trace_event_t;
+
+// Statischer Deskriptor pro Aufrufstelle, ID wird beim ersten Ereignis vergeben
+typedef struct {
+    const char* name;
+    uint32_t id;            // Wortbreite für atomaren Zugriff
+} trace_site_t;
+
+#if CONFIG_BENCH_TRACE
+
+void trace_emit(trace_site_t* site, uint8_t type, uint32_t arg);
+void trace_emit_id(uint16_t id, uint8_t type, uint32_t arg);
+uint16_t trace_intern(const char* name);
+void trace_clear(void);
+void trace_dump(void);
+
+#define TRACE_EMIT_(name, type, arg) do { \
+        static trace_site_t trace_site_ = { name, TRACE_ID_NONE }; \
+        trace_emit(&trace_site_, type, arg); \
+    } while (0)
+
+/**
+ * @brief Trace-Punkte; name muss ein String-Literal sein
+ * Bei CONFIG_BENCH_TRACE=n entfallen sie vollständig (Argumente werden nicht ausgewertet).
+ */
+#define TRACE_BEGIN(name)           TRACE_EMIT_(name, TRACE_EV_BEGIN, 0)
+#define TRACE_END(name)             TRACE_EMIT_(name, TRACE_EV_END, 0)
+#define TRACE_INSTANT(name, arg)    TRACE_EMIT_(name, TRACE_EV_INSTANT, arg)
+
+// Laufzeit-Namen (z. B. Benchmark-Namen): lineare Suche, nicht für heiße Pfade
+#define TRACE_BEGIN_DYN(name, arg)  trace_emit_id(trace_intern(name), TRACE_EV_BEGIN, arg)
+#define TRACE_END_DYN(name, arg)    trace_emit_id(trace_intern(name), TRACE_EV_END, arg)
+
+#else
+
+#define TRACE_BEGIN(name)           do { } while (0)
+#define TRACE_END(name)             do { } while (0)
+#define TRACE_INSTANT(name, arg)    do { } while (0)
+#define TRACE_BEGIN_DYN(name, arg)  do { } while (0)
+#define TRACE_END_DYN(name, arg)    do { } while (0)
+
+static inline void trace_clear(void) {}
+static inline void trace_dump(void) {}
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -13,8 +13,6 @@
 #define DEFAULT_ITERATIONS      100000
 #define WARMUP_ITERATIONS       1000
 
-// Timing Constants
-#define CPU_FREQUENCY_MHZ       160
-#define NS_PER_CYCLE            (1000 / CPU_FREQUENCY_MHZ)
+// Timing: CPU-Frequenz wird zur Laufzeit ermittelt (get_cpu_freq_mhz())
 
 #endif
\ No newline at end of file
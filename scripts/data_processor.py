@@ -0,0 +1,506 @@
+#!/usr/bin/env python3
+"""Ergebnis-Historie und Regressionserkennung für die Benchmark-Suite.
+
+Liest aufgezeichnete Mitschnitte (binärer Result-Stream oder CSV-Modus der
+Firmware, auch die CSV von ``serial_logger.py``) und hängt sie an einen
+spaltenorientierten Ergebnisspeicher an. Jeder Lauf ist über die
+``BUILD``-Zeile der Firmware gekennzeichnet::
+
+    BUILD,<FIRMWARE_VERSION>,<git-hash>,<target>-<optimierung>-<sdkconfig-prüfsumme>
+
+Unterbefehle::
+
+    ingest  <mitschnitt>...   Läufe in den Speicher übernehmen
+    runs                      Gespeicherte Läufe auflisten
+    compare                   Zwei Läufe pro Benchmark vergleichen
+    check   <mitschnitt>      ingest + compare gegen den Vorgänger (CI-Gate)
+    history <filter>          Median pro Lauf für passende Benchmarks
+
+``compare`` und ``check`` enden mit Exit-Code 1, wenn mindestens ein
+Benchmark signifikant langsamer geworden ist. Es wird kein Board benötigt.
+
+Speicher-Layout (nur anhängen)::
+
+    <store>/runs.jsonl        Ein Lauf pro Zeile; Commit-Punkt eines Ingests
+    <store>/tests.txt         Wörterbuch Testname -> Index (Zeilennummer)
+    <store>/col_<name>.bin    Eine Spalte pro Datei, little-endian uint32
+
+Spalten werden vor dem Lauf-Eintrag geschrieben. Bricht ein Ingest ab, sind
+die Spalten länger als ``rows_end`` des letzten Laufs; der Überhang wird
+beim nächsten Ingest abgeschnitten.
+"""
+import argparse
+import array
+import csv
+import fnmatch
+import hashlib
+import json
+import math
+import os
+import sys
+import time
+
+# Nachbarskripte auch beim Aufruf von außerhalb von scripts/ oder als Modul
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from serial_logger import FrameDecoder  # noqa: E402
+
+DEFAULT_STORE = 'results_store'
+COLUMNS = ('run', 'test', 'iterations', 'cycles', 'checksum')
+UNKNOWN = 'unknown'
+
+
+# ============ MITSCHNITT EINLESEN ============
+class ParsedRun:
+    """Datensätze und Kennung eines Mitschnitts"""
+
+    def __init__(self):
+        self.version = UNKNOWN
+        self.git = UNKNOWN
+        self.config = UNKNOWN
+        self.records = []       # (test_name, iterations, cycles, checksum)
+        self.lost = 0
+        self.dropped = 0
+
+
+def parse_text_line(line, run, csv_columns):
+    """Wertet eine Textzeile aus: BUILD-Kennung oder CSV-Datensatz"""
+    line = line.strip()
+    if line.startswith('BUILD,'):
+        fields = line.split(',')
+        if len(fields) >= 4:
+            run.version, run.git, run.config = fields[1], fields[2], ','.join(fields[3:])
+        return csv_columns
+    if line.startswith('seq,test_name,'):
+        return line.split(',')
+    if csv_columns and line[:1].isdigit():
+        fields = next(csv.reader([line]))
+        if len(fields) == len(csv_columns):
+            row = dict(zip(csv_columns, fields))
+            try:
+                run.records.append((row['test_name'], int(row['iterations']), int(row['total_cycles']),
+                                    int(row.get('result_value') or 0)))
+            except (KeyError, ValueError):
+                pass
+    return csv_columns
+
+
+def parse_log(data):
+    """Erkennt das Format (Nullbytes = binär) und sammelt alle Datensätze"""
+    run = ParsedRun()
+    csv_columns = None
+    if b'\x00' in data:
+        decoder = FrameDecoder()
+        pending = ''
+        for kind, value in decoder.feed(data + b'\x00'):
+            if kind == 'record':
+                run.records.append((value['test_name'], value['iterations'], value['total_cycles'],
+                                    value['result_value']))
+            elif kind == 'dropped':
+                run.dropped = value
+            elif kind == 'text':
+                lines = (pending + value).split('\n')
+                pending = lines.pop()
+                for line in lines:
+                    csv_columns = parse_text_line(line, run, csv_columns)
+        parse_text_line(pending, run, csv_columns)
+        run.lost = decoder.lost
+    else:
+        for line in data.decode('utf-8', errors='replace').splitlines():
+            csv_columns = parse_text_line(line, run, csv_columns)
+    return run
+
+
+# ============ ERGEBNISSPEICHER ============
+class ResultStore:
+    """Spaltenorientierter Speicher, nur anhängen"""
+
+    def __init__(self, path):
+        self.path = path
+        self.runs = []
+        self.tests = []
+        runs_file = os.path.join(path, 'runs.jsonl')
+        if os.path.exists(runs_file):
+            with open(runs_file, encoding='utf-8') as f:
+                self.runs = [json.loads(line) for line in f if line.strip()]
+        tests_file = os.path.join(path, 'tests.txt')
+        if os.path.exists(tests_file):
+            with open(tests_file, encoding='utf-8') as f:
+                self.tests = [line.rstrip('\n') for line in f]
+        self.rows = self.runs[-1]['rows_end'] if self.runs else 0
+        self._columns = None
+
+    def _column_file(self, name):
+        return os.path.join(self.path, f'col_{name}.bin')
+
+    def column(self, name):
+        """Lädt eine Spalte (nur festgeschriebene Zeilen)"""
+        if self._columns is None:
+            self._columns = {}
+        if name not in self._columns:
+            values = array.array('I')
+            path = self._column_file(name)
+            if os.path.exists(path):
+                with open(path, 'rb') as f:
+                    values.frombytes(f.read(self.rows * values.itemsize))
+            if sys.byteorder != 'little':
+                values.byteswap()
+            self._columns[name] = values
+        return self._columns[name]
+
+    def find_run(self, sha1):
+        return next((r for r in self.runs if r['sha1'] == sha1), None)
+
+    def append(self, parsed, source, sha1):
+        """Hängt einen Lauf an; Spalten zuerst, runs.jsonl zuletzt (Commit)"""
+        os.makedirs(self.path, exist_ok=True)
+        index = {name: i for i, name in enumerate(self.tests)}
+        new_tests = []
+        for name, _, _, _ in parsed.records:
+            if name not in index:
+                index[name] = len(self.tests) + len(new_tests)
+                new_tests.append(name)
+
+        run_id = len(self.runs)
+        columns = {name: array.array('I') for name in COLUMNS}
+        for name, iterations, cycles, checksum in parsed.records:
+            columns['run'].append(run_id)
+            columns['test'].append(index[name])
+            columns['iterations'].append(iterations & 0xFFFFFFFF)
+            columns['cycles'].append(cycles & 0xFFFFFFFF)
+            columns['checksum'].append(checksum & 0xFFFFFFFF)
+
+        itemsize = array.array('I').itemsize
+        for name, values in columns.items():
+            if sys.byteorder != 'little':
+                values.byteswap()
+            with open(self._column_file(name), 'ab') as f:
+                f.truncate(self.rows * itemsize)
+                f.write(values.tobytes())
+                f.flush()
+                os.fsync(f.fileno())
+        if new_tests:
+            with open(os.path.join(self.path, 'tests.txt'), 'a', encoding='utf-8') as f:
+                f.writelines(name + '\n' for name in new_tests)
+            self.tests += new_tests
+
+        run = {
+            'run': run_id,
+            'version': parsed.version,
+            'git': parsed.git,
+            'config': parsed.config,
+            'source': os.path.basename(source),
+            'sha1': sha1,
+            'ingested': time.strftime('%Y-%m-%dT%H:%M:%S'),
+            'rows_start': self.rows,
+            'rows_end': self.rows + len(parsed.records),
+            'lost': parsed.lost,
+            'dropped': parsed.dropped,
+        }
+        with open(os.path.join(self.path, 'runs.jsonl'), 'a', encoding='utf-8') as f:
+            f.write(json.dumps(run) + '\n')
+            f.flush()
+            os.fsync(f.fileno())
+        self.runs.append(run)
+        self.rows = run['rows_end']
+        self._columns = None
+        return run
+
+    def samples(self, runs, pattern=None):
+        """Zyklen pro Operation je Test über die angegebenen Läufe"""
+        tests = self.column('test')
+        iterations = self.column('iterations')
+        cycles = self.column('cycles')
+        result = {}
+        for run in runs:
+            for row in range(run['rows_start'], run['rows_end']):
+                name = self.tests[tests[row]]
+                if pattern and not fnmatch.fnmatchcase(name, pattern):
+                    continue
+                if iterations[row]:
+                    result.setdefault(name, []).append(cycles[row] / iterations[row])
+        return result
+
+
+# ============ STATISTIK ============
+def median(values):
+    ordered = sorted(values)
+    n = len(ordered)
+    mid = n // 2
+    return ordered[mid] if n % 2 else (ordered[mid - 1] + ordered[mid]) / 2
+
+
+def mann_whitney_greater(baseline, candidate):
+    """Einseitiger Mann-Whitney-U-Test (Kandidat größer als Baseline)
+
+    Normalapproximation mit Bindungs- und Stetigkeitskorrektur.
+    Rückgabe: p-Wert
+    """
+    n1, n2 = len(candidate), len(baseline)
+    combined = sorted([(v, 0) for v in candidate] + [(v, 1) for v in baseline])
+    ranks = [0.0] * len(combined)
+    ties = 0.0
+    i = 0
+    while i < len(combined):
+        j = i
+        while j + 1 < len(combined) and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        rank = (i + j) / 2 + 1
+        for k in range(i, j + 1):
+            ranks[k] = rank
+        t = j - i + 1
+        ties += t ** 3 - t
+        i = j + 1
+
+    rank_sum = sum(r for r, (_, group) in zip(ranks, combined) if group == 0)
+    u = rank_sum - n1 * (n1 + 1) / 2
+    n = n1 + n2
+    variance = n1 * n2 / 12 * ((n + 1) - ties / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    z = (u - n1 * n2 / 2 - 0.5) / math.sqrt(variance)
+    return 0.5 * math.erfc(z / math.sqrt(2))
+
+
+def median_ci(values, z=1.96):
+    """Verteilungsfreies Konfidenzintervall des Medians (Rangstatistiken)"""
+    ordered = sorted(values)
+    n = len(ordered)
+    half = z * math.sqrt(n) / 2
+    lower = max(0, int(math.floor(n / 2 - half)))
+    upper = min(n - 1, int(math.ceil(n / 2 + half)))
+    return ordered[lower], ordered[upper]
+
+
+def compare_samples(baseline, candidate, method, alpha, min_effect):
+    """Bewertet einen Test: 'regression', 'improvement' oder 'same'"""
+    base_med, cand_med = median(baseline), median(candidate)
+    delta = (cand_med - base_med) / base_med if base_med else 0.0
+    if method == 'mwu':
+        p_slower = mann_whitney_greater(baseline, candidate)
+        p_faster = mann_whitney_greater(candidate, baseline)
+        slower, faster = p_slower < alpha, p_faster < alpha
+        p = min(p_slower, p_faster)
+    else:
+        base_lo, base_hi = median_ci(baseline)
+        cand_lo, cand_hi = median_ci(candidate)
+        slower, faster = cand_lo > base_hi, cand_hi < base_lo
+        p = None
+
+    if slower and delta > min_effect:
+        verdict = 'regression'
+    elif faster and delta < -min_effect:
+        verdict = 'improvement'
+    else:
+        verdict = 'same'
+    return base_med, cand_med, delta, p, verdict
+
+
+# ============ LAUFAUSWAHL ============
+def select_runs(store, selector):
+    """Läufe zu einem Selektor: <nr>, run:<nr>, git:<hash>, version:<v>, config:<c>
+
+    Mehrere passende Läufe werden zusammengelegt (z. B. alle Läufe eines Commits).
+    """
+    if selector is None:
+        return []
+    key, _, value = selector.partition(':')
+    if not value:
+        key, value = 'run', selector
+    if key == 'run':
+        try:
+            index = int(value)
+        except ValueError:
+            return []
+        return [store.runs[index]] if -len(store.runs) <= index < len(store.runs) else []
+    if key in ('git', 'version', 'config'):
+        return [r for r in store.runs if r[key] == value or (key == 'git' and r[key].startswith(value))]
+    return []
+
+
+def default_baseline(store, candidate):
+    """Letzter früherer Lauf mit gleicher Build-Konfiguration"""
+    first = min(r['run'] for r in candidate)
+    config = candidate[0]['config']
+    for run in reversed(store.runs[:first]):
+        if run['config'] == config:
+            return [run]
+    return []
+
+
+def describe(runs):
+    run = runs[-1]
+    label = ','.join(str(r['run']) for r in runs)
+    return f"Lauf {label} ({run['version']}, {run['git']}, {run['config']})"
+
+
+# ============ BEFEHLE ============
+def ingest_file(store, path, args):
+    with open(path, 'rb') as f:
+        data = f.read()
+    sha1 = hashlib.sha1(data).hexdigest()
+    existing = store.find_run(sha1)
+    if existing:
+        print(f"ℹ️  {path} bereits als Lauf {existing['run']} gespeichert", file=sys.stderr)
+        return existing
+
+    parsed = parse_log(data)
+    if args.version:
+        parsed.version = args.version
+    if args.git:
+        parsed.git = args.git
+    if args.config:
+        parsed.config = args.config
+    if not parsed.records:
+        print(f"⚠️  {path}: keine Datensätze gefunden", file=sys.stderr)
+        return None
+
+    run = store.append(parsed, path, sha1)
+    print(f"✅ {path}: Lauf {run['run']}, {len(parsed.records)} Datensätze, "
+          f"{run['version']} {run['git']} {run['config']}", file=sys.stderr)
+    if parsed.lost or parsed.dropped:
+        print(f"⚠️  {parsed.lost} Lücken in der Sequenz, {parsed.dropped} von der Firmware verworfen",
+              file=sys.stderr)
+    return run
+
+
+def cmd_ingest(store, args):
+    runs = [ingest_file(store, path, args) for path in args.logs]
+    return 0 if all(runs) else 2
+
+
+def cmd_runs(store, args):
+    print(f"{'lauf':>4}  {'version':<10} {'git':<16} {'config':<28} {'zeilen':>7}  quelle")
+    for run in store.runs:
+        print(f"{run['run']:>4}  {run['version']:<10} {run['git']:<16} {run['config']:<28} "
+              f"{run['rows_end'] - run['rows_start']:>7}  {run['source']}")
+    return 0
+
+
+def compare_runs(store, baseline, candidate, args):
+    """Vergleicht zwei Laufmengen pro Benchmark; Exit-Code 1 bei Regression"""
+    if not candidate:
+        print('❌ Kein Kandidatenlauf gefunden', file=sys.stderr)
+        return 2
+    if not baseline:
+        print(f"ℹ️  Keine Baseline für {describe(candidate)} - nichts zu vergleichen", file=sys.stderr)
+        return 0
+    if not args.any_config and {r['config'] for r in baseline} != {candidate[0]['config']}:
+        print('❌ Baseline und Kandidat haben unterschiedliche Build-Konfigurationen '
+              '(--any-config erzwingt den Vergleich)', file=sys.stderr)
+        return 2
+
+    base = store.samples(baseline, args.filter)
+    cand = store.samples(candidate, args.filter)
+    min_effect = args.min_effect / 100.0
+
+    print(f"Baseline:  {describe(baseline)}")
+    print(f"Kandidat:  {describe(candidate)}")
+    print(f"Methode:   {'Mann-Whitney-U' if args.method == 'mwu' else 'KI-Überlappung'}, "
+          f"alpha {args.alpha}, Mindesteffekt {args.min_effect}%\n")
+    print(f"{'test':<32} {'baseline':>10} {'kandidat':>10} {'delta':>8} {'p':>8}  urteil")
+
+    regressions = 0
+    for name in sorted(set(base) | set(cand)):
+        if name not in base or name not in cand:
+            print(f"{name:<32} {'-' if name not in base else f'{median(base[name]):.3f}':>10} "
+                  f"{'-' if name not in cand else f'{median(cand[name]):.3f}':>10} {'':>8} {'':>8}  fehlt")
+            continue
+        if min(len(base[name]), len(cand[name])) < args.min_samples:
+            print(f"{name:<32} {median(base[name]):>10.3f} {median(cand[name]):>10.3f} {'':>8} {'':>8}  zu wenige Samples")
+            continue
+        base_med, cand_med, delta, p, verdict = compare_samples(base[name], cand[name], args.method,
+                                                                args.alpha, min_effect)
+        label = {'regression': '❌ REGRESSION', 'improvement': '✅ schneller', 'same': ''}[verdict]
+        p_text = f'{p:.1e}' if p is not None else '-'
+        print(f"{name:<32} {base_med:>10.3f} {cand_med:>10.3f} {delta * 100:>+7.1f}% {p_text:>8}  {label}")
+        regressions += verdict == 'regression'
+
+    if regressions:
+        print(f"\n❌ {regressions} Regression(en)", file=sys.stderr)
+        return 1
+    print('\n✅ Keine Regressionen', file=sys.stderr)
+    return 0
+
+
+def cmd_compare(store, args):
+    candidate = select_runs(store, args.candidate) if args.candidate else store.runs[-1:]
+    baseline = select_runs(store, args.baseline) if args.baseline else \
+        (default_baseline(store, candidate) if candidate else [])
+    return compare_runs(store, baseline, candidate, args)
+
+
+def cmd_check(store, args):
+    args.logs = [args.log]
+    run = ingest_file(store, args.log, args)
+    if run is None:
+        return 2
+    baseline = select_runs(store, args.baseline) if args.baseline else default_baseline(store, [run])
+    return compare_runs(store, baseline, [run], args)
+
+
+def cmd_history(store, args):
+    per_run = [(run, store.samples([run], args.filter)) for run in store.runs]
+    names = sorted({name for _, samples in per_run for name in samples})
+    if not names:
+        print(f"Keine Benchmarks passend zu \"{args.filter}\"", file=sys.stderr)
+        return 2
+    for name in names:
+        print(f"\n{name} (Zyklen pro Operation, Median)")
+        for run, samples in per_run:
+            if name in samples:
+                print(f"  {run['run']:>4}  {run['git']:<16} {run['config']:<28} {median(samples[name]):>10.3f}"
+                      f"  n={len(samples[name])}")
+    return 0
+
+
+def add_compare_options(parser):
+    parser.add_argument('--filter', help='Glob auf Testnamen (z. B. "mul*")')
+    parser.add_argument('--method', choices=('mwu', 'ci'), default='mwu',
+                        help='mwu = Mann-Whitney-U, ci = Überlappung der Median-Konfidenzintervalle')
+    parser.add_argument('--alpha', type=float, default=0.01, help='Signifikanzniveau (mwu)')
+    parser.add_argument('--min-effect', type=float, default=1.0, help='Mindeständerung des Medians in Prozent')
+    parser.add_argument('--min-samples', type=int, default=5, help='Mindestanzahl Samples pro Seite')
+    parser.add_argument('--any-config', action='store_true', help='Auch unterschiedliche Build-Konfigurationen vergleichen')
+    parser.add_argument('--baseline', help='Selektor: <nr>, run:<nr>, git:<hash>, version:<v>, config:<c>')
+
+
+def add_ingest_options(parser):
+    parser.add_argument('--version', help='FIRMWARE_VERSION überschreiben (fehlt die BUILD-Zeile)')
+    parser.add_argument('--git', help='Git-Hash überschreiben')
+    parser.add_argument('--config', help='Build-Konfiguration überschreiben')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='ESP32-C6 Benchmark-Historie und Regressionserkennung')
+    parser.add_argument('--store', default=DEFAULT_STORE, help=f'Ergebnisspeicher (Standard: {DEFAULT_STORE})')
+    sub = parser.add_subparsers(dest='command', required=True)
+
+    p = sub.add_parser('ingest', help='Mitschnitte in den Speicher übernehmen')
+    p.add_argument('logs', nargs='+', help='Mitschnitte (binär oder CSV)')
+    add_ingest_options(p)
+    p.set_defaults(func=cmd_ingest)
+
+    p = sub.add_parser('runs', help='Gespeicherte Läufe auflisten')
+    p.set_defaults(func=cmd_runs)
+
+    p = sub.add_parser('compare', help='Zwei Läufe vergleichen (Exit-Code 1 bei Regression)')
+    p.add_argument('--candidate', help='Selektor des Kandidaten (Standard: letzter Lauf)')
+    add_compare_options(p)
+    p.set_defaults(func=cmd_compare)
+
+    p = sub.add_parser('check', help='Mitschnitt übernehmen und gegen den Vorgänger prüfen')
+    p.add_argument('log', help='Mitschnitt (binär oder CSV)')
+    add_ingest_options(p)
+    add_compare_options(p)
+    p.set_defaults(func=cmd_check)
+
+    p = sub.add_parser('history', help='Median pro Lauf für passende Benchmarks')
+    p.add_argument('filter', nargs='?', default='*', help='Glob auf Testnamen')
+    p.set_defaults(func=cmd_history)
+
+    args = parser.parse_args()
+    return args.func(ResultStore(args.store), args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Assembler gegen C-Referenzkernel pro Optimierungsstufe.
+
+Stellt pro Kernel (z. B. ``add.lat``) die Zyklen pro Operation des
+Assembler-Kernels und jeder C-Variante (``cref.<kernel>.<variante>``)
+nebeneinander, dazu die Codegröße aus der Map-Datei des Linkers::
+
+    python3 scripts/opt_matrix.py --map build/test.map --log run.bin
+
+Zyklen: Median pro Test aus einem Mitschnitt (binär oder CSV, siehe
+data_processor.py). Größen: Eingabesektionen ``.text.ck_<variante>_<ident>``
+der C-Varianten und ``.text.<mangled kernel_<ident>>`` der Assembler-Kernel
+(-ffunction-sections). Beim Assembler-Kernel zählt die ganze Funktion, bei
+den C-Varianten ebenso - inklusive Messklammer.
+
+Abzüge: beide Seiten ohne Messklammer und ohne einen kalibrierten
+Schleifendurchlauf pro Durchlauf der (Quell-)Schleife; der Assembler-Kernel
+zusätzlich ohne Prolog/Epilog, den die C-Variante vor der Klammer erledigt.
+Der Faktor enthält damit nur, was der Compiler an Schleifencode über die
+kalibrierte Schleife hinaus erzeugt (bei ``u``-Varianten auch einspart).
+"""
+import argparse
+import os
+import re
+import sys
+
+# Nachbarskripte auch beim Aufruf von außerhalb von scripts/ oder als Modul
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from data_processor import median, parse_log  # noqa: E402
+
+# Sektion in der Map: Name allein in der Zeile, Adresse/Größe in der nächsten
+SECTION_RE = re.compile(r'^\s*(\.(?:text|iram1|literal)\.\S+)(?:\s+0x([0-9a-f]+)\s+0x([0-9a-f]+))?')
+ADDR_SIZE_RE = re.compile(r'^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s')
+C_SYMBOL_RE = re.compile(r'ck_([A-Za-z0-9]+)_(\w+)$')
+# Assembler-Kernel: Messrumpf raw_<ident> plus Hülle kernel_<ident> (Abzug der
+# Overheads), beide zählen zur Größe; die Rahmen-Kalibrierung (frame_*) nicht
+ASM_SYMBOL_RE = re.compile(r'(?:kernel|raw)_(?!frame_)(\w+?)ILb([01])E')
+
+
+def parse_map(lines):
+    """Codegröße pro Kernel und Variante aus einer GNU-ld-Map
+
+    Rückgabe: {(kernel, variante): bytes}, Variante 'asm' für Assembler-Kernel
+    """
+    sizes = {}
+    pending = None
+    for line in lines:
+        if pending is not None:
+            match = ADDR_SIZE_RE.match(line)
+            if match:
+                add_section(sizes, pending, int(match.group(2), 16))
+            pending = None
+            continue
+        match = SECTION_RE.match(line)
+        if not match:
+            continue
+        if match.group(3) is None:
+            pending = match.group(1)
+        else:
+            add_section(sizes, match.group(1), int(match.group(3), 16))
+    return sizes
+
+
+def add_section(sizes, section, size):
+    name = section.split('.', 2)[2]
+    c_match = C_SYMBOL_RE.search(name)
+    if c_match:
+        variant, ident = c_match.groups()
+        key = (ident_to_kernel(ident), variant)
+    else:
+        asm_match = ASM_SYMBOL_RE.search(name)
+        if not asm_match:
+            return
+        ident, throughput = asm_match.groups()
+        key = (f"{ident.rstrip('_')}.{'thr' if throughput == '1' else 'lat'}", 'asm')
+    if size:
+        sizes[key] = sizes.get(key, 0) + size
+
+
+def ident_to_kernel(ident):
+    """add_lat -> add.lat (Gegenstück in C_KERNEL_LIST, c_kernels.h)"""
+    base, _, kind = ident.rpartition('_')
+    return f'{base}.{kind}' if kind in ('lat', 'thr') else ident
+
+
+def parse_cycles(data):
+    """Median Zyklen pro Operation je (kernel, variante) aus einem Mitschnitt"""
+    samples = {}
+    for name, iterations, cycles, _ in parse_log(data).records:
+        if not iterations:
+            continue
+        if name.startswith('cref.'):
+            kernel, _, variant = name[len('cref.'):].rpartition('.')
+        else:
+            kernel, variant = name, 'asm'
+        samples.setdefault((kernel, variant), []).append(cycles / iterations)
+    return {key: median(values) for key, values in samples.items()}
+
+
+def variant_order(variant):
+    """asm zuerst, dann O0 < Og < Os < O2 < O3, ausgerollt jeweils dahinter"""
+    order = ['asm', 'O0', 'Og', 'Os', 'O2', 'O2u', 'O3', 'O3u']
+    return (order.index(variant), '') if variant in order else (len(order), variant)
+
+
+def print_table(title, values, kernels, variants, fmt):
+    print(f'\n=== {title} ===')
+    print(f"{'kernel':<10}" + ''.join(f'{v:>10}' for v in variants))
+    for kernel in kernels:
+        cells = [fmt(values[(kernel, v)]) if (kernel, v) in values else '-' for v in variants]
+        print(f'{kernel:<10}' + ''.join(f'{c:>10}' for c in cells))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Assembler vs. C-Optimierungsstufen (Zyklen und Codegröße)')
+    parser.add_argument('--map', default='build/test.map', help='Map-Datei des Linkers')
+    parser.add_argument('--log', help='Mitschnitt eines Laufs mit "bench -f cref" und den Assembler-Kerneln')
+    args = parser.parse_args()
+
+    sizes = {}
+    try:
+        with open(args.map, encoding='utf-8', errors='replace') as f:
+            sizes = parse_map(f)
+    except OSError as e:
+        print(f'⚠️  Map-Datei nicht lesbar: {e}', file=sys.stderr)
+
+    cycles = {}
+    if args.log:
+        with open(args.log, 'rb') as f:
+            cycles = parse_cycles(f.read())
+
+    # Nur Kernel mit C-Variante; Assembler-Kernel ohne Gegenstück interessieren hier nicht
+    kernels = sorted({k for k, v in list(sizes) + list(cycles) if v != 'asm'})
+    variants = sorted({v for _, v in list(sizes) + list(cycles)}, key=variant_order)
+    if not kernels:
+        print('❌ Keine C-Referenzkernel gefunden (Map-Datei oder Mitschnitt angeben)', file=sys.stderr)
+        return 1
+
+    if cycles:
+        print_table('ZYKLEN PRO OPERATION (Median)', cycles, kernels, variants, lambda v: f'{v:.3f}')
+        speedups = {(k, v): cycles[(k, v)] / cycles[(k, 'asm')] for k, v in cycles
+                    if v != 'asm' and (k, 'asm') in cycles and cycles[(k, 'asm')] > 0}
+        print_table('C / ASM (Faktor, >1 = Assembler schneller)', speedups, kernels,
+                    [v for v in variants if v != 'asm'], lambda v: f'{v:.2f}x')
+        print('Beide Seiten ohne Messklammer und kalibrierte Schleife pro Quelldurchlauf; '
+              'Rest der Compiler-Schleife zählt zur C-Variante')
+    if sizes:
+        print_table('CODEGRÖSSE (Byte, ganze Funktion)', sizes, kernels, variants, str)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
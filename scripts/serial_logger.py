@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+"""Dekodiert die COBS-gerahmten Binärdatensätze des ESP32-C6 Result-Sinks.
+
+Quelle ist entweder die serielle Schnittstelle oder ein aufgezeichneter
+Rohdaten-Mitschnitt (z. B. ``idf.py monitor`` Log oder ``cat /dev/ttyUSB0``).
+Ergebnis ist CSV auf stdout bzw. in ``--out``; Textausgaben der Firmware
+werden unverändert auf stderr durchgereicht. PMU-Zählerstände gehen als
+eigene CSV in ``--pmu-out``, sonst als Zusammenfassung (IPC) auf stderr.
+
+Frame-Layout (siehe components/benchmarks/result_sink.h):
+    0x00 | COBS( magic 0xB5 | typ | nutzdaten | crc8 ) | 0x00
+
+Dasselbe Format liefert der Konsolenbefehl ``log -d`` für das Ergebnislog im
+Flash; jede Sitzung beginnt dort mit einem BOOT-Frame (Test-IDs neu vergeben).
+"""
+import argparse
+import csv
+import struct
+import sys
+
+FRAME_MAGIC = 0xB5
+FRAME_RECORD = 0x01
+FRAME_TEST_NAME = 0x02
+FRAME_DROPPED = 0x03
+FRAME_PMU = 0x04
+FRAME_BOOT = 0x05
+
+# test_id, seq, iterations, cycles, checksum
+RECORD_STRUCT = struct.Struct('<HHIII')
+# test_id, event, reps, iterations, count
+PMU_STRUCT = struct.Struct('<HBBII')
+
+# Reihenfolge wie pmu_event_t in components/benchmarks/pmu.h
+PMU_EVENTS = ['cycles', 'inst', 'ld_hazard', 'jmp_hazard', 'idle', 'load', 'store',
+              'jmp_uncond', 'branch', 'branch_taken', 'inst_comp', 'icache_miss']
+
+CSV_FIELDS = ['seq', 'test_name', 'iterations', 'total_cycles', 'cycles_per_op', 'result_value']
+PMU_CSV_FIELDS = ['test_name', 'event', 'reps', 'iterations', 'count', 'count_per_op']
+
+
+def crc8(data):
+    """CRC-8, Polynom 0x07 (identisch zur Firmware)"""
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def cobs_decode(data):
+    """Dekodiert einen COBS-Block (ohne Begrenzer); None bei ungültigen Daten"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class FrameDecoder:
+    """Zerlegt einen Bytestrom in Frames und Text"""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.test_names = {}
+        self.last_seq = None
+        self.lost = 0
+
+    def feed(self, data):
+        """Verarbeitet neue Bytes und liefert Ereignisse (typ, wert)"""
+        self.buffer += data
+        while True:
+            end = self.buffer.find(b'\x00')
+            if end < 0:
+                break
+            chunk = bytes(self.buffer[:end])
+            del self.buffer[:end + 1]
+            if chunk:
+                yield from self._handle_chunk(chunk)
+
+    def _handle_chunk(self, chunk):
+        frame = cobs_decode(chunk)
+        if frame is None or len(frame) < 3 or frame[0] != FRAME_MAGIC or crc8(frame[:-1]) != frame[-1]:
+            # Kein gültiger Frame: Textausgabe der Firmware
+            yield 'text', chunk.decode('utf-8', errors='replace')
+            return
+
+        frame_type, payload = frame[1], frame[2:-1]
+        if frame_type == FRAME_TEST_NAME and len(payload) >= 2:
+            test_id = struct.unpack_from('<H', payload)[0]
+            self.test_names[test_id] = payload[2:].decode('utf-8', errors='replace')
+        elif frame_type == FRAME_RECORD and len(payload) == RECORD_STRUCT.size:
+            test_id, seq, iterations, cycles, checksum = RECORD_STRUCT.unpack(payload)
+            if self.last_seq is not None:
+                self.lost += (seq - self.last_seq - 1) & 0xFFFF
+            self.last_seq = seq
+            yield 'record', {
+                'seq': seq,
+                'test_name': self.test_names.get(test_id, f'test_{test_id}'),
+                'iterations': iterations,
+                'total_cycles': cycles,
+                'cycles_per_op': f'{cycles / iterations:.3f}' if iterations else '',
+                'result_value': checksum,
+            }
+        elif frame_type == FRAME_DROPPED and len(payload) == 4:
+            yield 'dropped', struct.unpack('<I', payload)[0]
+        elif frame_type == FRAME_BOOT and len(payload) >= 2:
+            # Neue Sitzung aus dem Ergebnislog: IDs und Sequenz beginnen neu
+            self.test_names = {}
+            self.last_seq = None
+            yield 'boot', (struct.unpack_from('<H', payload)[0], payload[2:].decode('utf-8', errors='replace'))
+        elif frame_type == FRAME_PMU and len(payload) == PMU_STRUCT.size:
+            test_id, event, reps, iterations, count = PMU_STRUCT.unpack(payload)
+            yield 'pmu', {
+                'test_name': self.test_names.get(test_id, f'test_{test_id}'),
+                'event': PMU_EVENTS[event] if event < len(PMU_EVENTS) else f'event_{event}',
+                'reps': reps,
+                'iterations': iterations,
+                'count': count,
+                'count_per_op': f'{count / iterations:.3f}' if iterations else '',
+            }
+
+
+class PmuSummary:
+    """Sammelt PMU-Zählerstände pro Test und leitet IPC und Stall-Anteile ab"""
+
+    STALLS = ('ld_hazard', 'jmp_hazard', 'idle')
+
+    def __init__(self):
+        self.tests = {}
+
+    def add(self, row):
+        self.tests.setdefault(row['test_name'], {})[row['event']] = row['count']
+
+    def lines(self):
+        for name, counts in self.tests.items():
+            cycles = counts.get('cycles')
+            if not cycles:
+                continue
+            parts = []
+            if 'inst' in counts:
+                parts.append(f"IPC {counts['inst'] / cycles:.3f}")
+            parts += [f'{ev} {100.0 * counts[ev] / cycles:.1f}%' for ev in self.STALLS if ev in counts]
+            if parts:
+                yield f"{name}: {' | '.join(parts)}"
+
+
+def open_source(args):
+    """Öffnet Datei, stdin oder serielle Schnittstelle als Bytestrom"""
+    if args.file == '-':
+        return sys.stdin.buffer
+    if args.file:
+        return open(args.file, 'rb')
+
+    import serial
+    print(f"📡 Verbinde mit {args.port} ({args.baud} Baud)...", file=sys.stderr)
+    return serial.Serial(args.port, args.baud, timeout=1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='ESP32-C6 Benchmark Binär-Logger')
+    parser.add_argument('--port', default='/dev/ttyUSB0', help='Serielle Schnittstelle')
+    parser.add_argument('--baud', type=int, default=115200, help='Baudrate')
+    parser.add_argument('--file', help="Aufgezeichneten Mitschnitt lesen ('-' = stdin)")
+    parser.add_argument('--out', help='CSV-Ausgabedatei (Standard: stdout)')
+    parser.add_argument('--pmu-out', help='CSV-Ausgabedatei für PMU-Zählerstände (Standard: Zusammenfassung auf stderr)')
+    parser.add_argument('--quiet', action='store_true', help='Textausgaben der Firmware unterdrücken')
+    args = parser.parse_args()
+
+    source = open_source(args)
+    out = open(args.out, 'w', newline='') if args.out else sys.stdout
+    writer = csv.DictWriter(out, fieldnames=CSV_FIELDS)
+    writer.writeheader()
+    pmu_out = open(args.pmu_out, 'w', newline='') if args.pmu_out else None
+    pmu_writer = csv.DictWriter(pmu_out, fieldnames=PMU_CSV_FIELDS) if pmu_out else None
+    if pmu_writer:
+        pmu_writer.writeheader()
+
+    decoder = FrameDecoder()
+    pmu_summary = PmuSummary()
+    records = 0
+    try:
+        while True:
+            data = source.read(4096)
+            if not data:
+                if args.file:
+                    break
+                continue
+            for kind, value in decoder.feed(data):
+                if kind == 'record':
+                    writer.writerow(value)
+                    records += 1
+                elif kind == 'pmu':
+                    pmu_summary.add(value)
+                    if pmu_writer:
+                        pmu_writer.writerow(value)
+                elif kind == 'boot':
+                    print(f"ℹ️  Sitzung {value[0]} aus dem Ergebnislog ({value[1]})", file=sys.stderr)
+                elif kind == 'dropped':
+                    print(f"⚠️  Firmware hat {value} Datensätze verworfen (Ringpuffer voll)", file=sys.stderr)
+                elif not args.quiet:
+                    sys.stderr.write(value)
+            out.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if decoder.buffer and not args.quiet:
+            sys.stderr.write(decoder.buffer.decode('utf-8', errors='replace'))
+        if out is not sys.stdout:
+            out.close()
+        if pmu_out:
+            pmu_out.close()
+
+    if not pmu_out:
+        for line in pmu_summary.lines():
+            print(f"PMU {line}", file=sys.stderr)
+
+    print(f"✅ {records} Datensätze dekodiert, {decoder.lost} Lücken in der Sequenz", file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
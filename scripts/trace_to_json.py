@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""Wandelt den Trace-Dump der Firmware in Chrome-Trace-JSON um.
+
+Eingabe ist ein Konsolen-Mitschnitt (Target oder linux-Target) mit den Zeilen
+von ``trace_dump()`` (siehe components/benchmarks/trace.c)::
+
+    TRACE_START,<cpu_mhz>,<cores>
+    TRACE_SITE,<id>,<name>
+    TRACE_EV,<core>,<typ>,<zyklen>,<us>,<id>,<arg>
+    TRACE_STOP,<überschriebene ereignisse>
+
+Andere Zeilen werden ignoriert. Enthält der Mitschnitt mehrere Dumps, wird
+jeder als eigener Prozess ausgegeben. Das Ergebnis lässt sich in
+chrome://tracing oder https://ui.perfetto.dev öffnen.
+"""
+import argparse
+import json
+import sys
+
+WRAP = 1 << 32
+
+
+class TraceDump:
+    """Ein Dump zwischen TRACE_START und TRACE_STOP"""
+
+    def __init__(self, cpu_mhz, cores):
+        self.cpu_mhz = cpu_mhz if cpu_mhz > 0 else 1
+        self.cores = cores
+        self.sites = {}
+        self.events = []
+        self.overwritten = 0
+
+
+def parse_dumps(lines):
+    """Sammelt alle Dumps aus einem Mitschnitt"""
+    dumps = []
+    current = None
+    for line in lines:
+        line = line.strip()
+        if not line.startswith('TRACE_'):
+            continue
+        fields = line.split(',')
+        try:
+            if fields[0] == 'TRACE_START':
+                current = TraceDump(int(fields[1]), int(fields[2]))
+                dumps.append(current)
+            elif current is None:
+                continue
+            elif fields[0] == 'TRACE_SITE':
+                # Namen dürfen Kommas enthalten
+                current.sites[int(fields[1])] = ','.join(fields[2:])
+            elif fields[0] == 'TRACE_EV':
+                core, kind, cycles, time_us, site, arg = fields[1:7]
+                current.events.append((int(core), kind, int(cycles), int(time_us), int(site), int(arg)))
+            elif fields[0] == 'TRACE_STOP':
+                current.overwritten = int(fields[1])
+                current = None
+        except (ValueError, IndexError):
+            print(f'Ungültige Trace-Zeile: {line}', file=sys.stderr)
+    return dumps
+
+
+def unwrap_cycles(dump):
+    """Entfaltet die 32-Bit-Zyklen anhand der Mikrosekunden.
+
+    Der Versatz zwischen beiden Uhren wird am ersten Ereignis bestimmt; danach
+    wird pro Ereignis das Vielfache von 2^32 gewählt, das der groben Zeit am
+    nächsten liegt. Rückgabe: Zeitstempel in µs relativ zum ersten Ereignis.
+    """
+    if not dump.events:
+        return []
+    mhz = dump.cpu_mhz
+    first = min(dump.events, key=lambda ev: ev[3])
+    offset = first[2] - first[3] * mhz
+    stamps = []
+    for _, _, cycles, time_us, _, _ in dump.events:
+        predicted = time_us * mhz + offset
+        wraps = round((predicted - cycles) / WRAP)
+        stamps.append((cycles + wraps * WRAP - first[2]) / mhz)
+    return stamps
+
+
+def to_chrome(dumps):
+    """Chrome-Trace-Ereignisse: pid = Dump, tid = Kern"""
+    trace = []
+    for pid, dump in enumerate(dumps):
+        trace.append({'name': 'process_name', 'ph': 'M', 'pid': pid, 'tid': 0,
+                      'args': {'name': f'ESP32-C6 Trace {pid} ({dump.cpu_mhz} MHz)'}})
+        for core in range(dump.cores):
+            trace.append({'name': 'thread_name', 'ph': 'M', 'pid': pid, 'tid': core,
+                          'args': {'name': f'Kern {core}'}})
+        if dump.overwritten:
+            print(f'Dump {pid}: {dump.overwritten} Ereignisse überschrieben', file=sys.stderr)
+
+        for (core, kind, cycles, _, site, arg), ts in zip(dump.events, unwrap_cycles(dump)):
+            event = {
+                'name': dump.sites.get(site, f'site{site}'),
+                'ph': kind,
+                'ts': round(ts, 3),
+                'pid': pid,
+                'tid': core,
+                'args': {'arg': arg, 'cycles': cycles},
+            }
+            if kind == 'i':
+                event['s'] = 't'
+            trace.append(event)
+    return {'traceEvents': trace, 'displayTimeUnit': 'ns'}
+
+
+def main():
+    parser = argparse.ArgumentParser(description='ESP32-C6 Trace-Dump nach Chrome-Trace-JSON')
+    parser.add_argument('input', nargs='?', default='-', help="Mitschnitt ('-' = stdin)")
+    parser.add_argument('--out', help='JSON-Ausgabedatei (Standard: stdout)')
+    args = parser.parse_args()
+
+    if args.input == '-':
+        dumps = parse_dumps(sys.stdin)
+    else:
+        with open(args.input, encoding='utf-8', errors='replace') as f:
+            dumps = parse_dumps(f)
+
+    if not dumps:
+        print('Kein Trace-Dump gefunden (TRACE_START fehlt)', file=sys.stderr)
+        return 1
+
+    result = to_chrome(dumps)
+    if args.out:
+        with open(args.out, 'w', encoding='utf-8') as f:
+            json.dump(result, f)
+    else:
+        json.dump(result, sys.stdout)
+        sys.stdout.write('\n')
+    print(f'{len(dumps)} Dump(s), {sum(len(d.events) for d in dumps)} Ereignisse', file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,25 @@
+"""Gemeinsame Fixtures der Skript-Tests (pytest).
+
+Die Skripte unter ``scripts/`` werden direkt importiert. Tests, die Ausgaben
+der Firmware brauchen, lesen den Mitschnitt des Host-Testlaufs, den
+``test/test_runner.py`` nach ``test/build/bench_test.log`` schreibt
+(oder ``BENCH_TEST_LOG``); ohne Mitschnitt werden sie übersprungen.
+"""
+import os
+import sys
+
+import pytest
+
+TEST_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SCRIPTS_DIR = os.path.join(os.path.dirname(TEST_DIR), 'scripts')
+sys.path.insert(0, SCRIPTS_DIR)
+
+
+@pytest.fixture
+def bench_log():
+    """Rohbytes des letzten Host-Testlaufs"""
+    path = os.environ.get('BENCH_TEST_LOG', os.path.join(TEST_DIR, 'build', 'bench_test.log'))
+    if not os.path.exists(path):
+        pytest.skip(f'{path} fehlt (python3 test/test_runner.py)')
+    with open(path, 'rb') as f:
+        return f.read()
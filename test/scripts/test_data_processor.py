@@ -0,0 +1,115 @@
+"""Ergebnisspeicher und Statistik von scripts/data_processor.py"""
+import os
+import subprocess
+import sys
+
+import pytest
+
+import data_processor
+from data_processor import ParsedRun, ResultStore, compare_samples, mann_whitney_greater, median_ci
+
+
+def parsed(*records):
+    run = ParsedRun()
+    run.records = [(name, iterations, cycles, 0) for name, iterations, cycles in records]
+    return run
+
+
+def column_rows(store, name):
+    return os.path.getsize(os.path.join(store.path, f'col_{name}.bin')) // 4
+
+
+# ============ IMPORT ============
+def test_import_from_foreign_directory(tmp_path):
+    # Als Modul über den Dateipfad geladen, scripts/ steht nicht in sys.path
+    code = ('import importlib.util as u; '
+            f's = u.spec_from_file_location("dp", {data_processor.__file__!r}); '
+            'm = u.module_from_spec(s); s.loader.exec_module(m); print(m.FrameDecoder.__name__)')
+    env = dict(os.environ, PYTHONPATH='')
+    out = subprocess.run([sys.executable, '-c', code], cwd=tmp_path, env=env,
+                         capture_output=True, text=True, check=True)
+    assert out.stdout.strip() == 'FrameDecoder'
+
+
+# ============ SPEICHER ============
+def test_reopen_truncates_aborted_ingest(tmp_path):
+    path = str(tmp_path / 'store')
+    store = ResultStore(path)
+    store.append(parsed(('a', 10, 100), ('b', 10, 200)), 'run0.bin', 'sha0')
+
+    # Abgebrochener Ingest: Spalten und tests.txt geschrieben, runs.jsonl nicht
+    for name in data_processor.COLUMNS:
+        with open(os.path.join(path, f'col_{name}.bin'), 'ab') as f:
+            f.write(b'\xff' * 12)
+    with open(os.path.join(path, 'tests.txt'), 'a', encoding='utf-8') as f:
+        f.write('orphan\n')
+
+    store = ResultStore(path)
+    assert store.rows == 2
+    assert list(store.column('cycles')) == [100, 200]
+
+    run = store.append(parsed(('a', 10, 110), ('c', 10, 300)), 'run1.bin', 'sha1')
+    assert (run['rows_start'], run['rows_end']) == (2, 4)
+    for name in data_processor.COLUMNS:
+        assert column_rows(store, name) == 4
+
+    store = ResultStore(path)
+    assert list(store.column('cycles')) == [100, 200, 110, 300]
+    assert store.samples(store.runs[:1]) == {'a': [10.0], 'b': [20.0]}
+    assert store.samples(store.runs[1:]) == {'a': [11.0], 'c': [30.0]}
+
+
+def test_test_index_stable_across_ingests(tmp_path):
+    path = str(tmp_path / 'store')
+    store = ResultStore(path)
+    store.append(parsed(('a', 1, 1), ('b', 1, 2)), 'run0.bin', 'sha0')
+    store.append(parsed(('c', 1, 3), ('a', 1, 4), ('b', 1, 5)), 'run1.bin', 'sha1')
+
+    store = ResultStore(path)
+    assert store.tests == ['a', 'b', 'c']
+    assert list(store.column('test')) == [0, 1, 2, 0, 1]
+
+    # Name aus einem abgebrochenen Ingest behält seinen Index
+    with open(os.path.join(path, 'tests.txt'), 'a', encoding='utf-8') as f:
+        f.write('d\n')
+    store = ResultStore(path)
+    store.append(parsed(('e', 1, 6), ('d', 1, 7)), 'run2.bin', 'sha2')
+    assert ResultStore(path).tests == ['a', 'b', 'c', 'd', 'e']
+    assert list(store.column('test'))[5:] == [4, 3]
+
+
+# ============ STATISTIK ============
+BASE = [float(v) for v in range(1, 21)]
+
+
+def test_mann_whitney_known_samples():
+    low, high = BASE[:10], BASE[10:]
+    # U = 100, Erwartung 50, Varianz 175: z = 49.5 / sqrt(175)
+    assert mann_whitney_greater(low, high) == pytest.approx(9.13e-5, rel=1e-2)
+    assert mann_whitney_greater(high, low) == pytest.approx(1.0, abs=1e-4)
+
+    # Verschachtelt: kein Unterschied
+    assert 0.3 < mann_whitney_greater(BASE[0::2], BASE[1::2]) < 0.7
+
+    # Alle Werte gleich: Varianz 0
+    assert mann_whitney_greater([5.0] * 8, [5.0] * 8) == 1.0
+
+
+def test_median_ci_known_samples():
+    # n = 20: Ränge floor(10 - 4.38) und ceil(10 + 4.38)
+    assert median_ci(BASE) == (6.0, 16.0)
+    assert median_ci([7.0]) == (7.0, 7.0)
+
+
+def test_ci_overlap_decides_verdict():
+    shifted = [v + 10 for v in BASE]    # CI 16..26, berührt 6..16
+    assert compare_samples(BASE, shifted, 'ci', 0.01, 0.02)[4] == 'same'
+
+    slower = [v + 20 for v in BASE]     # CI 26..36
+    base_med, cand_med, delta, p, verdict = compare_samples(BASE, slower, 'ci', 0.01, 0.02)
+    assert (base_med, cand_med, p, verdict) == (10.5, 30.5, None, 'regression')
+    assert delta == pytest.approx(20 / 10.5)
+
+    assert compare_samples(slower, BASE, 'ci', 0.01, 0.02)[4] == 'improvement'
+    # Signifikant, aber unter der Mindestwirkung
+    assert compare_samples(BASE, slower, 'ci', 0.01, 5.0)[4] == 'same'
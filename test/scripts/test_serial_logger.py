@@ -0,0 +1,37 @@
+"""Decoder von scripts/serial_logger.py gegen Frames der Firmware"""
+import serial_logger
+from serial_logger import FrameDecoder
+
+# Gleiche Werte in test/test_result_sink.c
+LF_TEST_NAME = 'lf\nframe'
+
+
+def decode(data):
+    decoder = FrameDecoder()
+    return list(decoder.feed(data)), decoder
+
+
+def test_record_with_lf_bytes_round_trip(bench_log):
+    events, _ = decode(bench_log)
+    records = [value for kind, value in events if kind == 'record' and value['test_name'] == LF_TEST_NAME]
+    assert records == [{
+        'seq': 0x0A0A,
+        'test_name': LF_TEST_NAME,
+        'iterations': 0x0A0A0A0A,
+        'total_cycles': 0x000A0D0A,
+        'cycles_per_op': f'{0x000A0D0A / 0x0A0A0A0A:.3f}',
+        'result_value': 0x0A00000A,
+    }]
+
+
+def test_crlf_translated_frame_is_not_a_record(bench_log):
+    # So sah der Strom aus, solange die Konsole vor jedes 0x0A ein 0x0D setzte
+    events, _ = decode(bench_log.replace(b'\n', b'\r\n'))
+    names = [value['test_name'] for kind, value in events if kind == 'record']
+    assert LF_TEST_NAME not in names
+    assert LF_TEST_NAME.replace('\n', '\r\n') not in names
+
+
+def test_cobs_decode_rejects_truncated_block():
+    assert serial_logger.cobs_decode(b'\x05ab') is None
+    assert serial_logger.cobs_decode(b'\x03ab\x01') == b'ab\x00'
@@ -0,0 +1,69 @@
+"""scripts/trace_to_json.py gegen Trace-Dumps der Firmware (test/test_trace.c)"""
+import json
+
+from trace_to_json import parse_dumps, to_chrome, unwrap_cycles
+
+# Gleiche Werte in test/test_trace.c
+WRAP_EXTRA = 5
+
+
+def dumps_of(bench_log):
+    return parse_dumps(bench_log.decode('utf-8', errors='replace').splitlines())
+
+
+def dump_with(dumps, name):
+    """Der Dump, dessen Ereignisse die Stelle name enthalten"""
+    for dump in dumps:
+        ids = {site for site, site_name in dump.sites.items() if site_name == name}
+        if any(ev[4] in ids for ev in dump.events):
+            return dump
+    raise AssertionError(f'kein Dump mit Ereignissen von {name}')
+
+
+def named(dump):
+    """(name, typ, arg) pro Ereignis"""
+    return [(dump.sites[ev[4]], ev[1], ev[5]) for ev in dump.events]
+
+
+def test_span_dump_round_trip(bench_log):
+    dump = dump_with(dumps_of(bench_log), 'test.trace.span')
+    assert dump.cores == 1
+    assert dump.overwritten == 0
+    assert named(dump) == [
+        ('test.trace.span', 'B', 0),
+        ('test.trace.mark', 'i', 42),
+        ('test.trace.dyn', 'B', 7),
+        ('test.trace.dyn', 'E', 7),
+        ('test.trace.span', 'E', 0),
+    ]
+    stamps = unwrap_cycles(dump)
+    assert stamps[0] == 0
+    assert stamps == sorted(stamps)
+
+
+def test_wrapped_ring_keeps_newest(bench_log):
+    dump = dump_with(dumps_of(bench_log), 'test.trace.wrap')
+    assert dump.overwritten == WRAP_EXTRA
+    args = [arg for name, kind, arg in named(dump)]
+    assert args == list(range(WRAP_EXTRA, WRAP_EXTRA + len(dump.events)))
+    assert all(kind == 'i' for _, kind, _ in named(dump))
+
+
+def test_emit_benchmarks_write_real_ring(bench_log):
+    # Ein Dump pro Benchmark: Messereignisse "trace.bench", zuletzt das Ende des Benchmarks
+    for bench in ('trace.emit', 'trace.emit_id'):
+        events = named(dump_with(dumps_of(bench_log), bench))
+        assert (bench, 'E') in [(name, kind) for name, kind, _ in events]
+        assert any(name == 'trace.bench' and kind == 'i' for name, kind, _ in events)
+
+
+def test_chrome_export(bench_log):
+    dumps = dumps_of(bench_log)
+    dump = dump_with(dumps, 'test.trace.span')
+    trace = json.loads(json.dumps(to_chrome([dump])))
+    events = [ev for ev in trace['traceEvents'] if ev['ph'] != 'M']
+    assert [ev['name'] for ev in events] == [
+        'test.trace.span', 'test.trace.mark', 'test.trace.dyn', 'test.trace.dyn', 'test.trace.span']
+    assert events[1]['s'] == 't'
+    assert events[1]['args']['arg'] == 42
+    assert all(ev['pid'] == 0 and ev['tid'] == 0 for ev in events)
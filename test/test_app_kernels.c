@@ -0,0 +1,106 @@
+// Anwendungskernel (app_kernels.c): Referenzvektoren und Gleichheit der Varianten
+
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "app_kernels.h"
+#include "app_bench.h"
+
+#define BULK_BYTES      1031    // Ungerade, nicht blockweise teilbar
+
+static void fill(uint8_t* buf, uint32_t len, uint32_t seed) {
+    for (uint32_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(i * 97 + seed);
+    }
+}
+
+TEST_CASE("App-Kernel: alle Referenzvektoren bestanden", "[app]")
+{
+    TEST_ASSERT_EQUAL_UINT32(0, app_kernels_verify());
+}
+
+TEST_CASE("App-Kernel: mbedtls stimmt mit der Softwarefassung überein", "[app]")
+{
+    TEST_ASSERT_EQUAL_UINT32(0, app_bench_verify());
+}
+
+TEST_CASE("App-Kernel: CRC-32 und Fletcher-32 gleich bei jeder Ausrichtung und Länge", "[app]")
+{
+    uint8_t* buf = malloc(BULK_BYTES + 4);
+    TEST_ASSERT_NOT_NULL(buf);
+    fill(buf, BULK_BYTES + 4, 5);
+
+    // Versatz 1..3: Wortvarianten fallen auf die Bytevariante zurück
+    for (uint32_t off = 0; off < 4; off++) {
+        for (uint32_t len = 0; len <= BULK_BYTES; len += (len < 16) ? 1 : 61) {
+            const uint8_t* data = buf + off;
+            uint32_t crc = crc32_naive(data, len);
+            uint32_t sum = fletcher32_naive(data, len);
+            TEST_ASSERT_EQUAL_UINT32(crc, crc32_table(data, len));
+            TEST_ASSERT_EQUAL_UINT32(crc, crc32_slice4(data, len));
+            TEST_ASSERT_EQUAL_UINT32(sum, fletcher32_blocked(data, len));
+            TEST_ASSERT_EQUAL_UINT32(sum, fletcher32_word(data, len));
+        }
+    }
+    free(buf);
+}
+
+TEST_CASE("App-Kernel: SHA-256 gleich über Blockgrenzen", "[app]")
+{
+    uint8_t buf[200];
+    uint8_t naive[32], unrolled[32];
+    fill(buf, sizeof(buf), 11);
+
+    // 55/56/64 Byte: Padding passt noch bzw. braucht einen zweiten Block
+    for (uint32_t len = 0; len <= sizeof(buf); len++) {
+        sha256_naive(buf, len, naive);
+        sha256_unrolled(buf, len, unrolled);
+        TEST_ASSERT_EQUAL_UINT32(0, memcmp(naive, unrolled, sizeof(naive)));
+    }
+}
+
+TEST_CASE("App-Kernel: AES-128-CBC gleich, auch in-place", "[app]")
+{
+    static const uint8_t raw[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                     0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    uint8_t pt[256], naive[256], inplace[256];
+    uint8_t iv_naive[16] = { 0 }, iv_ttable[16] = { 0 };
+    aes128_key_t key;
+
+    fill(pt, sizeof(pt), 23);
+    aes128_expand_key(&key, raw);
+    aes128_cbc_naive(&key, iv_naive, pt, naive, sizeof(pt));
+    memcpy(inplace, pt, sizeof(pt));
+    aes128_cbc_ttable(&key, iv_ttable, inplace, inplace, sizeof(pt));
+
+    TEST_ASSERT_EQUAL_UINT32(0, memcmp(naive, inplace, sizeof(naive)));
+    // IV enthält danach den letzten Chiffreblock (Verkettung über Aufrufe)
+    TEST_ASSERT_EQUAL_UINT32(0, memcmp(iv_naive, naive + sizeof(naive) - 16, 16));
+    TEST_ASSERT_EQUAL_UINT32(0, memcmp(iv_naive, iv_ttable, 16));
+}
+
+TEST_CASE("App-Kernel: Q15-FIR und Skalarprodukt gleich", "[app]")
+{
+    static int16_t x[67] __attribute__((aligned(4)));
+    static int16_t h[7];
+    int16_t y_naive[67], y_unrolled[67];
+
+    for (uint32_t i = 0; i < 67; i++) {
+        x[i] = (int16_t)((int32_t)(i * 7919) % 65536 - 32768);
+    }
+    // Betragssumme unter 1.0
+    for (uint32_t k = 0; k < 7; k++) {
+        h[k] = (int16_t)((k & 1) ? -4000 : 4000);
+    }
+
+    for (uint32_t taps = 1; taps <= 7; taps++) {
+        memset(y_naive, 0, sizeof(y_naive));
+        memset(y_unrolled, 0, sizeof(y_unrolled));
+        fir_q15_naive(x, 67, h, taps, y_naive);
+        fir_q15_unrolled(x, 67, h, taps, y_unrolled);
+        TEST_ASSERT_EQUAL_UINT32(0, memcmp(y_naive, y_unrolled, (67 - taps + 1) * sizeof(int16_t)));
+    }
+    for (uint32_t n = 0; n <= 67; n++) {
+        TEST_ASSERT_EQUAL_INT32(dot_q15_naive(x, x, n), dot_q15_unrolled(x, x, n));
+    }
+}
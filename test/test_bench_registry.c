@@ -0,0 +1,156 @@
+// Registry und Runner (bench_registry.c): Filter, Reihenfolge, Iterationen
+
+#include <string.h>
+#include "unity.h"
+#include "bench_registry.h"
+
+// ============ HILFSFUNKTIONEN ============
+#define DEF(name, suite, tags, iterations, granularity) \
+    { name, suite, tags, iterations, granularity, record_call, NULL, 0, BENCH_TEST_ID_NONE, NULL }
+
+static uint32_t s_calls;
+static uint32_t s_last_iterations;
+
+static uint32_t record_call(void* arg, uint32_t iterations, uint32_t* result) {
+    (void)arg;
+    s_calls++;
+    s_last_iterations = iterations;
+    *result = iterations;
+    return 1000;                // Konstant: Abbruch nach min_samples
+}
+
+/**
+ * @brief Führt genau die Benchmarks mit diesem Namen aus
+ * @return Iterationen des letzten Aufrufs
+ */
+static uint32_t run_named(const char* name, uint32_t iterations) {
+    bench_run_spec_t spec;
+    bench_run_spec_default(&spec);
+    spec.filter = name;
+    spec.repeat = 1;
+    spec.iterations = iterations;
+    spec.pmu_events = 0;
+
+    s_calls = 0;
+    s_last_iterations = UINT32_MAX;
+    TEST_ASSERT_EQUAL_UINT32(1, bench_run(&spec));
+    TEST_ASSERT_TRUE(s_calls > 0);
+    return s_last_iterations;
+}
+
+// ============ FILTER ============
+TEST_CASE("Filter: Name, Suite und Tags per Glob", "[registry]")
+{
+    const bench_def_t def = DEF("mulh.lat", "micro", "muldiv,latency", 1, 1);
+
+    // Leer bzw. NULL wählt alles
+    TEST_ASSERT_TRUE(bench_matches(&def, NULL));
+    TEST_ASSERT_TRUE(bench_matches(&def, ""));
+
+    // Name
+    TEST_ASSERT_TRUE(bench_matches(&def, "mulh.lat"));
+    TEST_ASSERT_TRUE(bench_matches(&def, "mul*"));
+    TEST_ASSERT_TRUE(bench_matches(&def, "*.lat"));
+    TEST_ASSERT_TRUE(bench_matches(&def, "mulh.?at"));
+    TEST_ASSERT_TRUE(bench_matches(&def, "*"));
+    TEST_ASSERT_FALSE(bench_matches(&def, "mulh"));
+    TEST_ASSERT_FALSE(bench_matches(&def, "mulh.lat?"));
+    TEST_ASSERT_FALSE(bench_matches(&def, "mul"));
+
+    // Suite und einzelne Tags, jeweils ganz
+    TEST_ASSERT_TRUE(bench_matches(&def, "micro"));
+    TEST_ASSERT_TRUE(bench_matches(&def, "muldiv"));
+    TEST_ASSERT_TRUE(bench_matches(&def, "latency"));
+    TEST_ASSERT_TRUE(bench_matches(&def, "lat*"));
+    TEST_ASSERT_FALSE(bench_matches(&def, "memory"));
+    TEST_ASSERT_FALSE(bench_matches(&def, "div"));
+    TEST_ASSERT_FALSE(bench_matches(&def, "throughput"));
+}
+
+TEST_CASE("Filter: Komma-Liste, ein Treffer genügt", "[registry]")
+{
+    const bench_def_t def = DEF("add.thr", "micro", "alu,throughput", 1, 1);
+
+    TEST_ASSERT_TRUE(bench_matches(&def, "memory,add.*"));
+    TEST_ASSERT_TRUE(bench_matches(&def, "nothing,,throughput"));
+    TEST_ASSERT_FALSE(bench_matches(&def, "memory,latency"));
+    TEST_ASSERT_FALSE(bench_matches(&def, ","));
+}
+
+TEST_CASE("Filter: Benchmark ohne Tags", "[registry]")
+{
+    const bench_def_t def = DEF("plain", "power", NULL, 1, 1);
+
+    TEST_ASSERT_TRUE(bench_matches(&def, "plain"));
+    TEST_ASSERT_TRUE(bench_matches(&def, "power"));
+    TEST_ASSERT_FALSE(bench_matches(&def, "latency"));
+}
+
+// ============ REIHENFOLGE ============
+TEST_CASE("Registrierung: sortiert nach Suite und Name, unabhängig von der Reihenfolge", "[registry]")
+{
+    static bench_def_t defs[] = {
+        DEF("c", "zz.order.b", "", 1, 1),
+        DEF("b", "zz.order.a", "", 1, 1),
+        DEF("a", "zz.order.b", "", 1, 1),
+        DEF("dup", "zz.order.a", "first", 1, 1),
+        DEF("a", "zz.order.a", "", 1, 1),
+        DEF("dup", "zz.order.a", "second", 1, 1),
+    };
+    static const char* const expected[][2] = {
+        { "zz.order.a", "a" }, { "zz.order.a", "b" }, { "zz.order.a", "dup" }, { "zz.order.a", "dup" },
+        { "zz.order.b", "a" }, { "zz.order.b", "c" },
+    };
+    const size_t count = sizeof(defs) / sizeof(defs[0]);
+
+    for (size_t i = 0; i < count; i++) {
+        bench_register(&defs[i]);
+    }
+
+    size_t seen = 0;
+    const char* prev_suite = "";
+    for (const bench_def_t* def = bench_first(); def != NULL; def = def->next) {
+        // Gesamte Liste sortiert nach Suite
+        TEST_ASSERT_TRUE(strcmp(prev_suite, def->suite) <= 0);
+        prev_suite = def->suite;
+        if (strncmp(def->suite, "zz.order.", 9) != 0) {
+            continue;
+        }
+        TEST_ASSERT_TRUE(seen < count);
+        TEST_ASSERT_EQUAL_STRING(expected[seen][0], def->suite);
+        TEST_ASSERT_EQUAL_STRING(expected[seen][1], def->name);
+        seen++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(count, seen);
+
+    // Gleicher Name: Registrierungsreihenfolge bleibt erhalten
+    TEST_ASSERT_TRUE(defs[3].next == &defs[5]);
+    TEST_ASSERT_EQUAL_UINT32(6, bench_list("zz.order.*"));
+}
+
+// ============ RUNNER ============
+TEST_CASE("Runner: Iterationen auf Granulen gerundet, mindestens eine", "[registry]")
+{
+    static bench_def_t zero = DEF("zz.run.zero", "zz.run", "", 0, 0);
+    static bench_def_t granule = DEF("zz.run.granule", "zz.run", "", 20, 8);
+    bench_register(&zero);
+    bench_register(&granule);
+
+    // Standard 0 ohne Granularität: eine Operation statt Division durch 0
+    TEST_ASSERT_EQUAL_UINT32(1, run_named("zz.run.zero", 0));
+    // Standard 20, Granularität 8: abgerundet
+    TEST_ASSERT_EQUAL_UINT32(16, run_named("zz.run.granule", 0));
+    // Angefordert 3 < Granularität: eine Granule
+    TEST_ASSERT_EQUAL_UINT32(8, run_named("zz.run.granule", 3));
+    TEST_ASSERT_EQUAL_UINT32(40, run_named("zz.run.granule", 43));
+}
+
+TEST_CASE("Runner: kein Treffer führt nichts aus", "[registry]")
+{
+    bench_run_spec_t spec;
+    bench_run_spec_default(&spec);
+    spec.filter = "zz.none.*";
+    s_calls = 0;
+    TEST_ASSERT_EQUAL_UINT32(0, bench_run(&spec));
+    TEST_ASSERT_EQUAL_UINT32(0, s_calls);
+}
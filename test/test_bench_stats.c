@@ -0,0 +1,212 @@
+// Streaming-Statistik (bench_stats.c): Momente, Quantile, MAD-Filter, Abbruch
+
+#include <math.h>
+#include "unity.h"
+#include "bench_stats.h"
+#include "measurement_utils.h"
+
+// ============ HILFSFUNKTIONEN ============
+#define ARENA_SAMPLES   1000
+
+static uint32_t s_arena[ARENA_SAMPLES];
+
+/**
+ * @brief Permutation von 0..n-1 über einen multiplikativen Generator (n = 1000)
+ */
+static uint32_t shuffled(uint32_t i) {
+    return (i * 617u + 311u) % ARENA_SAMPLES;
+}
+
+typedef struct {
+    uint32_t calls;
+    uint32_t value;             // Konstantes Sample
+    uint32_t spread;            // > 0: value + (calls % spread)
+    uint64_t busy_us;           // Aktives Warten pro Sample
+} sample_src_t;
+
+static uint32_t next_sample(void* ctx) {
+    sample_src_t* src = ctx;
+    if (src->busy_us > 0) {
+        uint64_t start = get_time_us();
+        while (get_time_us() - start < src->busy_us) {
+        }
+    }
+    src->calls++;
+    return src->spread ? src->value + src->calls % src->spread : src->value;
+}
+
+static bench_adaptive_cfg_t test_cfg(uint32_t min_samples, uint32_t max_samples, double target, uint64_t budget_us) {
+    bench_adaptive_cfg_t cfg = {
+        .min_samples = min_samples,
+        .max_samples = max_samples,
+        .target_ci_rel = target,
+        .time_budget_us = budget_us,
+        .mad_threshold = 3.5,
+    };
+    return cfg;
+}
+
+// ============ QUANTILE UND MOMENTE ============
+TEST_CASE("P2: Median und p99 einer gemischten Rampe", "[stats]")
+{
+    p2_quantile_t median, p99;
+    p2_init(&median, 0.5);
+    p2_init(&p99, 0.99);
+    for (uint32_t i = 0; i < ARENA_SAMPLES; i++) {
+        p2_add(&median, shuffled(i));
+        p2_add(&p99, shuffled(i));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(10.0f, 499.5f, (float)p2_get(&median));
+    TEST_ASSERT_FLOAT_WITHIN(10.0f, 989.0f, (float)p2_get(&p99));
+}
+
+TEST_CASE("P2: unter fünf Werten exakt", "[stats]")
+{
+    p2_quantile_t median;
+    p2_init(&median, 0.5);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, (float)p2_get(&median));
+    p2_add(&median, 30);
+    p2_add(&median, 10);
+    p2_add(&median, 20);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, (float)p2_get(&median));
+}
+
+TEST_CASE("Zusammenfassung: bekannte Momente, Min/Max", "[stats]")
+{
+    bench_stats_t stats;
+    bench_summary_t summary;
+    bench_stats_init(&stats, s_arena, ARENA_SAMPLES);
+    for (uint32_t i = 0; i < ARENA_SAMPLES; i++) {
+        bench_stats_add(&stats, shuffled(i));
+    }
+    bench_stats_summarize(&stats, 3.5, &summary);
+
+    // 0..999: Mittelwert 499.5, Stichproben-Standardabweichung sqrt(1000 * 1001 / 12)
+    TEST_ASSERT_EQUAL_UINT32(ARENA_SAMPLES, summary.samples);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.min);
+    TEST_ASSERT_EQUAL_UINT32(ARENA_SAMPLES - 1, summary.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 499.5f, (float)summary.mean);
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f, 288.819f, (float)summary.stddev);
+    TEST_ASSERT_EQUAL_UINT32(ARENA_SAMPLES, summary.filtered);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.rejected);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 499.5f, (float)summary.filtered_mean);
+}
+
+TEST_CASE("Zusammenfassung: Streaming-Momente über die volle Arena hinaus", "[stats]")
+{
+    bench_stats_t stats;
+    bench_summary_t summary;
+    bench_stats_init(&stats, s_arena, 200);
+    for (uint32_t i = 0; i < ARENA_SAMPLES; i++) {
+        bench_stats_add(&stats, i);
+    }
+    bench_stats_summarize(&stats, 3.5, &summary);
+
+    // Mittelwert über alle 1000 Samples, der gefilterte nur über die ersten 200
+    TEST_ASSERT_EQUAL_UINT32(ARENA_SAMPLES, summary.samples);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 499.5f, (float)summary.mean);
+    TEST_ASSERT_EQUAL_UINT32(200, summary.filtered);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 99.5f, (float)summary.filtered_mean);
+    TEST_ASSERT_FLOAT_WITHIN(10.0f, 499.5f, (float)summary.median);
+}
+
+// ============ AUSREISSER ============
+TEST_CASE("MAD: Ausreißer verworfen, Streaming-Werte unverändert", "[stats]")
+{
+    bench_stats_t stats;
+    bench_summary_t summary;
+    bench_stats_init(&stats, s_arena, ARENA_SAMPLES);
+    for (uint32_t i = 0; i < 100; i++) {
+        bench_stats_add(&stats, 1000 + i % 5);      // 1000..1004
+    }
+    bench_stats_add(&stats, 100000);
+    bench_stats_add(&stats, 50000);
+    bench_stats_add(&stats, 1);
+    bench_stats_summarize(&stats, 3.5, &summary);
+
+    TEST_ASSERT_EQUAL_UINT32(103, summary.samples);
+    TEST_ASSERT_EQUAL_UINT32(3, summary.rejected);
+    TEST_ASSERT_EQUAL_UINT32(100, summary.filtered);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 1002.0f, (float)summary.filtered_mean);
+    TEST_ASSERT_TRUE(summary.mean > 2000.0);
+    TEST_ASSERT_EQUAL_UINT32(1, summary.min);
+    TEST_ASSERT_EQUAL_UINT32(100000, summary.max);
+    TEST_ASSERT_TRUE(summary.ci_rel < 0.01);
+}
+
+TEST_CASE("MAD: konstante Samples, MAD = 0 verwirft nichts", "[stats]")
+{
+    bench_stats_t stats;
+    bench_summary_t summary;
+    bench_stats_init(&stats, s_arena, ARENA_SAMPLES);
+    for (uint32_t i = 0; i < 50; i++) {
+        bench_stats_add(&stats, 42);
+    }
+    bench_stats_add(&stats, 43);
+    bench_stats_summarize(&stats, 3.5, &summary);
+
+    TEST_ASSERT_EQUAL_UINT32(0, summary.rejected);
+    TEST_ASSERT_EQUAL_UINT32(51, summary.filtered);
+}
+
+TEST_CASE("Zusammenfassung ohne Samples", "[stats]")
+{
+    bench_stats_t stats;
+    bench_summary_t summary;
+    bench_stats_init(&stats, s_arena, ARENA_SAMPLES);
+    bench_stats_summarize(&stats, 3.5, &summary);
+
+    TEST_ASSERT_EQUAL_UINT32(0, summary.samples);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.min);
+    TEST_ASSERT_TRUE(isinf(summary.ci_rel));
+}
+
+// ============ ABBRUCHKRITERIEN ============
+TEST_CASE("Adaptiv: konstante Samples enden bei min_samples", "[stats]")
+{
+    bench_stats_t stats;
+    bench_summary_t summary;
+    sample_src_t src = { .value = 1000 };
+    bench_adaptive_cfg_t cfg = test_cfg(16, ARENA_SAMPLES, 0.01, 10 * 1000 * 1000);
+
+    bench_stats_init(&stats, s_arena, ARENA_SAMPLES);
+    bench_stats_run_adaptive(&stats, &cfg, next_sample, &src, &summary);
+
+    TEST_ASSERT_EQUAL_UINT32(16, summary.samples);
+    TEST_ASSERT_EQUAL_UINT32(16, src.calls);
+    TEST_ASSERT_TRUE(summary.ci_rel <= cfg.target_ci_rel);
+}
+
+TEST_CASE("Adaptiv: unerreichbares Ziel endet bei max_samples bzw. Arena", "[stats]")
+{
+    bench_stats_t stats;
+    bench_summary_t summary;
+    sample_src_t src = { .value = 1000, .spread = 100 };
+    bench_adaptive_cfg_t cfg = test_cfg(16, 500, 0.0, 10 * 1000 * 1000);
+
+    bench_stats_init(&stats, s_arena, ARENA_SAMPLES);
+    bench_stats_run_adaptive(&stats, &cfg, next_sample, &src, &summary);
+    TEST_ASSERT_EQUAL_UINT32(500, summary.samples);
+
+    // Arena kleiner als max_samples: die Arena begrenzt
+    src.calls = 0;
+    bench_stats_init(&stats, s_arena, 100);
+    bench_stats_run_adaptive(&stats, &cfg, next_sample, &src, &summary);
+    TEST_ASSERT_EQUAL_UINT32(100, summary.samples);
+}
+
+TEST_CASE("Adaptiv: Zeitbudget greift auch vor min_samples", "[stats]")
+{
+    bench_stats_t stats;
+    bench_summary_t summary;
+    sample_src_t src = { .value = 1000, .busy_us = 1000 };
+    bench_adaptive_cfg_t cfg = test_cfg(ARENA_SAMPLES, ARENA_SAMPLES, 0.0, 20 * 1000);
+
+    bench_stats_init(&stats, s_arena, ARENA_SAMPLES);
+    bench_stats_run_adaptive(&stats, &cfg, next_sample, &src, &summary);
+
+    // 1 ms pro Sample, 20 ms Budget
+    TEST_ASSERT_TRUE(summary.samples >= 20);
+    TEST_ASSERT_TRUE(summary.samples < 100);
+    TEST_ASSERT_EQUAL_UINT32(src.calls, summary.samples);
+}
@@ -0,0 +1,19 @@
+// Host-Tests der Benchmark-Komponente (linux-Target)
+//
+// Ein Testprogramm für alle Module: jede test_<modul>.c registriert ihre Fälle
+// per TEST_CASE, app_main führt alle aus und beendet den Prozess mit der
+// Anzahl der Fehlschläge als Exit-Code (test_runner.py).
+
+#include <stdlib.h>
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "result_sink.h"
+
+void app_main(void) {
+    // Drain-Task für Benchmarks, die über den Runner laufen
+    result_sink_init();
+
+    UNITY_BEGIN();
+    unity_run_all_tests();
+    exit(UNITY_END());
+}
@@ -0,0 +1,72 @@
+// Zeigerketten (mem_bench.cpp): Sattolo ergibt genau einen Zyklus
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "mem_bench.h"
+#include "sdkconfig.h"
+
+#define MIN_BYTES       1024
+#define MAX_BYTES       (CONFIG_BENCH_MEM_HP_MAX_KB * 1024)
+
+static const uint32_t k_strides[] = { 4, 32, 128 };
+
+/**
+ * @brief Prüft Zykluslänge und Lage aller Knoten einer Kette
+ * Jeder Knoten muss genau einmal erreicht werden, jeder Nachfolger auf
+ * einem Knotenanfang (Vielfaches von stride plus Slot) liegen.
+ */
+static void check_chain(uint32_t* base, uint32_t bytes, uint32_t stride, uint32_t slot, uint32_t seed) {
+    const uint32_t nodes = bytes / stride;
+    char msg[64];
+    snprintf(msg, sizeof(msg), "%u Byte, Schrittweite %u, Slot %u", (unsigned)bytes, (unsigned)stride,
+             (unsigned)slot);
+
+    mem_chase_build(base, nodes, stride, slot, seed);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(nodes, mem_chase_cycle_length(base, slot, nodes), msg);
+
+    for (uint32_t i = 0; i < nodes; i++) {
+        uint32_t next = base[i * (stride / 4) + slot];
+        TEST_ASSERT_TRUE_MESSAGE(next < bytes, msg);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(slot * 4, next % stride, msg);
+    }
+}
+
+TEST_CASE("Sattolo: ein Zyklus über alle Knoten je Größe und Schrittweite", "[mem]")
+{
+    uint32_t* base = malloc(MAX_BYTES);
+    TEST_ASSERT_NOT_NULL(base);
+
+    // Wie mem_bench_register(): Größen in Zweierpotenzen, Startwert bytes ^ stride
+    for (uint32_t bytes = MIN_BYTES; bytes <= MAX_BYTES; bytes *= 2) {
+        for (size_t s = 0; s < sizeof(k_strides) / sizeof(k_strides[0]); s++) {
+            check_chain(base, bytes, k_strides[s], 0, bytes ^ k_strides[s]);
+        }
+    }
+    free(base);
+}
+
+TEST_CASE("Sattolo: Slots einer Cache-Zeile (Flash-Klassen) und andere Startwerte", "[mem]")
+{
+    uint32_t* base = malloc(MAX_BYTES);
+    TEST_ASSERT_NOT_NULL(base);
+
+    for (uint32_t slot = 0; slot < 8; slot++) {
+        check_chain(base, MAX_BYTES >> slot, 32, slot, 0);
+    }
+    for (uint32_t seed = 1; seed < 64; seed++) {
+        check_chain(base, 4096, 32, 0, seed * 2654435761u);
+    }
+    free(base);
+}
+
+TEST_CASE("Sattolo: Randfälle mit einem und zwei Knoten", "[mem]")
+{
+    uint32_t base[64];
+
+    check_chain(base, 32, 32, 0, 1);
+    TEST_ASSERT_EQUAL_UINT32(0, base[0]);
+    check_chain(base, 64, 32, 3, 1);
+    TEST_ASSERT_EQUAL_UINT32(32 + 3 * 4, base[3]);
+    TEST_ASSERT_EQUAL_UINT32(3 * 4, base[8 + 3]);
+}
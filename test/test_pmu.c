@@ -0,0 +1,164 @@
+// PMU-Abstraktion (pmu.c): Ereignislisten, Gruppenaufteilung, Runner ohne PMU
+
+#include <string.h>
+#include "unity.h"
+#include "pmu.h"
+#include "bench_registry.h"
+
+#define EV(name)        PMU_EVENT_BIT(PMU_EV_##name)
+
+// ============ EREIGNISLISTEN ============
+TEST_CASE("Ereignisliste: Namen und Sätze", "[pmu]")
+{
+    TEST_ASSERT_EQUAL_HEX32(EV(INSTRET), pmu_parse_events("inst"));
+    TEST_ASSERT_EQUAL_HEX32(EV(LD_HAZARD) | EV(ICACHE_MISS), pmu_parse_events("ld_hazard,icache_miss"));
+    TEST_ASSERT_EQUAL_HEX32(PMU_SET_IPC, pmu_parse_events("ipc"));
+    TEST_ASSERT_EQUAL_HEX32(PMU_SET_STALLS, pmu_parse_events("stalls"));
+    TEST_ASSERT_EQUAL_HEX32(PMU_SET_MEM | PMU_SET_BRANCH, pmu_parse_events("mem,branch"));
+    TEST_ASSERT_EQUAL_HEX32(PMU_SET_ALL, pmu_parse_events("all"));
+
+    // Leer
+    TEST_ASSERT_EQUAL_HEX32(0, pmu_parse_events(NULL));
+    TEST_ASSERT_EQUAL_HEX32(0, pmu_parse_events(""));
+    TEST_ASSERT_EQUAL_HEX32(0, pmu_parse_events(",,"));
+    TEST_ASSERT_EQUAL_HEX32(EV(IDLE), pmu_parse_events(",idle,"));
+}
+
+TEST_CASE("Ereignisliste: Unbekanntes wird übergangen", "[pmu]")
+{
+    TEST_ASSERT_EQUAL_HEX32(0, pmu_parse_events("bogus"));
+    TEST_ASSERT_EQUAL_HEX32(EV(INSTRET) | EV(IDLE), pmu_parse_events("inst,bogus,idle"));
+
+    // Nur ganze Namen, kein Präfix und keine Großschreibung
+    TEST_ASSERT_EQUAL_HEX32(0, pmu_parse_events("ins"));
+    TEST_ASSERT_EQUAL_HEX32(0, pmu_parse_events("instx"));
+    TEST_ASSERT_EQUAL_HEX32(0, pmu_parse_events("IPC"));
+}
+
+TEST_CASE("Ereignisliste: Doppelte Ereignisse zählen einmal", "[pmu]")
+{
+    TEST_ASSERT_EQUAL_HEX32(EV(INSTRET), pmu_parse_events("inst,inst"));
+    TEST_ASSERT_EQUAL_HEX32(PMU_SET_STALLS, pmu_parse_events("stalls,ipc,cycles"));
+    TEST_ASSERT_EQUAL_HEX32(PMU_SET_ALL, pmu_parse_events("all,stalls,inst"));
+}
+
+// ============ GRUPPEN ============
+TEST_CASE("Gruppen: ESP32-C6 mit einem Zähler", "[pmu]")
+{
+    uint32_t groups[PMU_EV_COUNT];
+
+    // Jedes Ereignis ein eigener Lauf, in Reihenfolge von pmu_event_t
+    TEST_ASSERT_EQUAL_UINT32(5, pmu_split_groups(PMU_SET_STALLS, 1, groups));
+    TEST_ASSERT_EQUAL_HEX32(EV(CYCLES), groups[0]);
+    TEST_ASSERT_EQUAL_HEX32(EV(INSTRET), groups[1]);
+    TEST_ASSERT_EQUAL_HEX32(EV(LD_HAZARD), groups[2]);
+    TEST_ASSERT_EQUAL_HEX32(EV(JMP_HAZARD), groups[3]);
+    TEST_ASSERT_EQUAL_HEX32(EV(IDLE), groups[4]);
+
+    TEST_ASSERT_EQUAL_UINT32(PMU_EV_COUNT, pmu_split_groups(PMU_SET_ALL, 1, groups));
+    for (uint32_t i = 0; i < PMU_EV_COUNT; i++) {
+        TEST_ASSERT_EQUAL_HEX32(PMU_EVENT_BIT(i), groups[i]);
+    }
+}
+
+TEST_CASE("Gruppen: linux mit vier Zählern", "[pmu]")
+{
+    uint32_t groups[PMU_EV_COUNT];
+
+    // Volle Gruppen zuerst, der Rest in der letzten
+    TEST_ASSERT_EQUAL_UINT32(2, pmu_split_groups(PMU_SET_STALLS, 4, groups));
+    TEST_ASSERT_EQUAL_HEX32(EV(CYCLES) | EV(INSTRET) | EV(LD_HAZARD) | EV(JMP_HAZARD), groups[0]);
+    TEST_ASSERT_EQUAL_HEX32(EV(IDLE), groups[1]);
+
+    TEST_ASSERT_EQUAL_UINT32(1, pmu_split_groups(PMU_SET_IPC, 4, groups));
+    TEST_ASSERT_EQUAL_HEX32(PMU_SET_IPC, groups[0]);
+
+    TEST_ASSERT_EQUAL_UINT32(3, pmu_split_groups(PMU_SET_ALL, 4, groups));
+    TEST_ASSERT_EQUAL_HEX32(0x00F, groups[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x0F0, groups[1]);
+    TEST_ASSERT_EQUAL_HEX32(0xF00, groups[2]);
+
+    // Lücken in der Maske: Gruppen nach Anzahl, nicht nach Position
+    TEST_ASSERT_EQUAL_UINT32(2, pmu_split_groups(EV(CYCLES) | EV(LOAD) | EV(STORE) | EV(BRANCH) | EV(ICACHE_MISS), 4, groups));
+    TEST_ASSERT_EQUAL_HEX32(EV(CYCLES) | EV(LOAD) | EV(STORE) | EV(BRANCH), groups[0]);
+    TEST_ASSERT_EQUAL_HEX32(EV(ICACHE_MISS), groups[1]);
+}
+
+TEST_CASE("Gruppen: ohne Zähler oder Ereignisse keine", "[pmu]")
+{
+    uint32_t groups[PMU_EV_COUNT];
+
+    TEST_ASSERT_EQUAL_UINT32(0, pmu_split_groups(PMU_SET_ALL, 0, groups));
+    TEST_ASSERT_EQUAL_UINT32(0, pmu_split_groups(0, 1, groups));
+    TEST_ASSERT_EQUAL_UINT32(0, pmu_split_groups(0, 4, groups));
+}
+
+// ============ OHNE PMU ============
+static uint32_t s_pmu_calls;        // Aufrufe als PMU-Last
+
+static uint32_t count_pmu_calls(void* arg, uint32_t iterations, uint32_t* result) {
+    (void)arg;
+    if (bench_pmu_active()) {
+        s_pmu_calls++;
+    }
+    *result = iterations;
+    return 1000;
+}
+
+static void count_workload(void* ctx) {
+    (*(uint32_t*)ctx)++;
+}
+
+/**
+ * @brief Führt zz.pmu.run mit allen PMU-Ereignissen aus
+ * @return Aufrufe als PMU-Last
+ */
+static uint32_t run_with_pmu(void) {
+    static bench_def_t def = {
+        "zz.pmu.run", "zz.pmu", "", 1, 1, count_pmu_calls, NULL, PMU_SET_ALL, BENCH_TEST_ID_NONE, NULL
+    };
+    static bool registered;
+    if (!registered) {
+        bench_register(&def);
+        registered = true;
+    }
+
+    bench_run_spec_t spec;
+    bench_run_spec_default(&spec);
+    spec.filter = "zz.pmu.run";
+    spec.repeat = 1;
+    spec.pmu_events = PMU_SET_ALL;
+
+    s_pmu_calls = 0;
+    TEST_ASSERT_EQUAL_UINT32(1, bench_run(&spec));
+    return s_pmu_calls;
+}
+
+TEST_CASE("Ohne PMU: keine Zähler, keine Läufe, keine PMU-Frames", "[pmu]")
+{
+    pmu_event_t ev = PMU_EV_CYCLES;
+    pmu_result_t result;
+    uint32_t calls = 0;
+
+    pmu_enable(false);
+    TEST_ASSERT_FALSE(pmu_available());
+    TEST_ASSERT_EQUAL_UINT32(0, pmu_counter_count());
+    TEST_ASSERT_EQUAL_HEX32(0, pmu_supported_events());
+    TEST_ASSERT_FALSE(pmu_start(&ev, 1));
+
+    // Messung ohne Last und ohne Ereignisse
+    memset(&result, 0xA5, sizeof(result));
+    pmu_measure(PMU_SET_ALL, 4, count_workload, &calls, &result);
+    TEST_ASSERT_EQUAL_UINT32(0, calls);
+    TEST_ASSERT_EQUAL_HEX32(0, result.events);
+
+    // Runner: PMU-Frames entstehen nur aus PMU-Läufen
+    uint32_t pmu_calls = run_with_pmu();
+    pmu_enable(true);
+    TEST_ASSERT_EQUAL_UINT32(0, pmu_calls);
+
+    // Gegenprobe, falls der Host perf-Zähler bereitstellt
+    if (pmu_available()) {
+        TEST_ASSERT_TRUE(run_with_pmu() > 0);
+    }
+}
@@ -0,0 +1,260 @@
+// Ergebnislog (result_log.c) auf der emulierten Partition (test/partitions.csv)
+//
+// Jeder Fall beginnt mit einem gelöschten Log; result_log_close() und
+// result_log_init() stehen für einen Neustart.
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "result_log.h"
+#include "esp_partition.h"
+
+#define BUILD           "0.0.0,host,linux-test"
+#define SECTOR_COUNT    4       // benchlog in test/partitions.csv
+
+typedef struct {
+    uint32_t entries[8];        // nach Frame-Typ
+    uint16_t boot[16];          // BOOT-Einträge in Log-Reihenfolge
+    uint32_t boots;
+    uint8_t named[RESULT_SINK_MAX_TESTS / 8];
+    uint32_t unnamed;           // Datensätze ohne vorherigen Namenseintrag
+    uint32_t records;
+    result_record_t first;
+    result_record_t last;
+    uint32_t out_of_order;      // Datensätze mit fallender seq
+    uint32_t dropped;
+} log_view_t;
+
+static void collect(const result_log_entry_t* entry, const uint8_t* payload, void* arg) {
+    log_view_t* view = (log_view_t*)arg;
+    uint16_t id;
+    view->entries[entry->type & 7]++;
+
+    switch (entry->type) {
+    case RESULT_FRAME_BOOT:
+        if (view->boots < sizeof(view->boot) / sizeof(view->boot[0])) {
+            memcpy(&view->boot[view->boots], payload, 2);
+        }
+        view->boots++;
+        TEST_ASSERT_EQUAL_UINT32(2 + strlen(BUILD), entry->len);
+        TEST_ASSERT_EQUAL_UINT32(0, memcmp(&payload[2], BUILD, strlen(BUILD)));
+        break;
+    case RESULT_FRAME_TEST_NAME:
+        memcpy(&id, payload, 2);
+        TEST_ASSERT_EQUAL_UINT32(2 + strlen(result_sink_test_name(id)), entry->len);
+        TEST_ASSERT_EQUAL_UINT32(0, memcmp(&payload[2], result_sink_test_name(id), entry->len - 2));
+        view->named[id / 8] |= (uint8_t)(1u << (id % 8));
+        break;
+    case RESULT_FRAME_RECORD: {
+        result_record_t rec;
+        TEST_ASSERT_EQUAL_UINT32(sizeof(rec), entry->len);
+        memcpy(&rec, payload, sizeof(rec));
+        if (!(view->named[rec.test_id / 8] & (1u << (rec.test_id % 8)))) {
+            view->unnamed++;
+        }
+        if (view->records == 0) {
+            view->first = rec;
+        } else if ((int16_t)(rec.seq - view->last.seq) <= 0) {
+            view->out_of_order++;
+        }
+        view->last = rec;
+        view->records++;
+        break;
+    }
+    case RESULT_FRAME_DROPPED:
+        TEST_ASSERT_EQUAL_UINT32(4, entry->len);
+        memcpy(&view->dropped, payload, 4);
+        break;
+    default:
+        break;
+    }
+}
+
+static size_t read_log(log_view_t* view) {
+    memset(view, 0, sizeof(*view));
+    return result_log_foreach(collect, view);
+}
+
+static void log_restart(void) {
+    result_log_close();
+    TEST_ASSERT_TRUE(result_log_init(BUILD));
+}
+
+static void log_fresh(void) {
+    TEST_ASSERT_TRUE(result_log_init(BUILD));
+    TEST_ASSERT_TRUE(result_log_erase());
+    log_restart();
+}
+
+/**
+ * @brief Hängt count Datensätze an, seq fortlaufend ab first_seq
+ * Ein Commit je batch Datensätze (wie run_one() nach jedem Benchmark).
+ */
+static void append_records(const uint16_t* ids, size_t id_count, uint32_t first_seq, uint32_t count,
+                           uint32_t batch) {
+    for (uint32_t i = 0; i < count; i++) {
+        result_record_t rec = {
+            .test_id = ids[i % id_count],
+            .seq = (uint16_t)(first_seq + i),
+            .iterations = 100,
+            .cycles = 1000 + i,
+            .checksum = (first_seq + i) * 7,
+        };
+        result_log_append_record(&rec);
+        if ((i + 1) % batch == 0) {
+            result_log_commit();
+        }
+    }
+    result_log_commit();
+}
+
+static const esp_partition_t* log_partition(void) {
+    const esp_partition_t* part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                                           CONFIG_BENCH_RESULT_LOG_PARTITION);
+    TEST_ASSERT_NOT_NULL(part);
+    return part;
+}
+
+/**
+ * @brief Sucht den neuesten Sektor und dessen Schreibende direkt im Flash
+ * @return Sektorindex, *end = Position hinter dem letzten Eintrag
+ */
+static uint32_t newest_sector(uint32_t* end, uint32_t* used) {
+    const esp_partition_t* part = log_partition();
+    uint32_t newest = UINT32_MAX;
+    uint32_t newest_seq = 0;
+    result_log_sector_t hdr;
+
+    *used = 0;
+    for (uint32_t i = 0; i < part->size / part->erase_size; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_partition_read(part, i * part->erase_size, &hdr, sizeof(hdr)));
+        if (hdr.magic != RESULT_LOG_SECTOR_MAGIC) {
+            continue;
+        }
+        (*used)++;
+        if (newest == UINT32_MAX || (int32_t)(hdr.seq - newest_seq) > 0) {
+            newest = i;
+            newest_seq = hdr.seq;
+        }
+    }
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, newest);
+
+    result_log_entry_t entry;
+    uint32_t off = sizeof(result_log_sector_t);
+    for (;;) {
+        TEST_ASSERT_EQUAL(ESP_OK, esp_partition_read(part, newest * part->erase_size + off, &entry, sizeof(entry)));
+        if (entry.type == 0xFF) {
+            break;
+        }
+        off += (sizeof(entry) + entry.len + 3u) & ~3u;
+    }
+    *end = off;
+    return newest;
+}
+
+TEST_CASE("Ergebnislog: Datensätze, Namen und Sitzung überstehen den Neustart", "[log]")
+{
+    const uint16_t ids[2] = { result_sink_register_test("log.a"), result_sink_register_test("log.b") };
+    log_view_t view;
+    log_fresh();
+
+    append_records(ids, 2, 0, 10, 10);
+    result_pmu_record_t pmu = { .test_id = ids[0], .event = 1, .reps = 4, .iterations = 100, .count = 42 };
+    result_log_append_pmu(&pmu);
+    result_log_append_dropped(3);
+    log_restart();
+
+    // BOOT + 2 Namen + 10 Datensätze + PMU + DROPPED
+    TEST_ASSERT_EQUAL_UINT32(15, read_log(&view));
+    TEST_ASSERT_EQUAL_UINT32(1, view.boots);
+    TEST_ASSERT_EQUAL_UINT32(1, view.boot[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, view.entries[RESULT_FRAME_TEST_NAME]);
+    TEST_ASSERT_EQUAL_UINT32(10, view.records);
+    TEST_ASSERT_EQUAL_UINT32(1, view.entries[RESULT_FRAME_PMU]);
+    TEST_ASSERT_EQUAL_UINT32(3, view.dropped);
+    TEST_ASSERT_EQUAL_UINT32(0, view.unnamed);
+    TEST_ASSERT_EQUAL_UINT32(0, view.out_of_order);
+    TEST_ASSERT_EQUAL_UINT32(9, view.last.seq);
+    TEST_ASSERT_EQUAL_UINT32(9 * 7, view.last.checksum);
+    TEST_ASSERT_EQUAL_UINT32(1009, view.last.cycles);
+
+    // Neue Sitzung hängt im selben Sektor an und nennt ihre Tests erneut
+    append_records(ids, 1, 10, 5, 5);
+    TEST_ASSERT_EQUAL_UINT32(15 + 1 + 1 + 5, read_log(&view));
+    TEST_ASSERT_EQUAL_UINT32(2, view.boots);
+    TEST_ASSERT_EQUAL_UINT32(2, view.boot[1]);
+    TEST_ASSERT_EQUAL_UINT32(15, view.records);
+    TEST_ASSERT_EQUAL_UINT32(0, view.out_of_order);
+
+    // Sitzungen ohne Einträge hinterlassen nichts und belegen keine Nummer
+    log_restart();
+    log_restart();
+    append_records(ids, 1, 15, 1, 1);
+    read_log(&view);
+    TEST_ASSERT_EQUAL_UINT32(3, view.boots);
+    TEST_ASSERT_EQUAL_UINT32(3, view.boot[2]);
+}
+
+TEST_CASE("Ergebnislog: Umlauf löscht den ältesten Sektor, Rest bleibt dekodierbar", "[log]")
+{
+    const uint16_t ids[3] = { result_sink_register_test("log.wrap.a"), result_sink_register_test("log.wrap.b"),
+                              result_sink_register_test("log.wrap.c") };
+    const uint32_t count = 2000;        // 40 KB Datensätze, Partition 16 KB
+    uint32_t end, used;
+    log_view_t view;
+    log_fresh();
+
+    append_records(ids, 3, 0, count, 100);
+    read_log(&view);
+    newest_sector(&end, &used);
+
+    TEST_ASSERT_EQUAL_UINT32(SECTOR_COUNT, used);
+    // Jeder Sektor beginnt mit BOOT und nennt seine Tests selbst
+    TEST_ASSERT_EQUAL_UINT32(SECTOR_COUNT, view.boots);
+    TEST_ASSERT_EQUAL_UINT32(0, view.unnamed);
+    TEST_ASSERT_EQUAL_UINT32(0, view.out_of_order);
+    TEST_ASSERT_TRUE(view.first.seq > 0);
+    TEST_ASSERT_EQUAL_UINT32(count - 1, view.last.seq);
+    // Lückenlos vom ältesten erhaltenen bis zum neuesten Datensatz
+    TEST_ASSERT_EQUAL_UINT32(count - view.first.seq, view.records);
+    TEST_ASSERT_EQUAL_UINT32(view.first.seq * 7, view.first.checksum);
+
+    // Auch nach dem Neustart an der richtigen Stelle weiter
+    log_restart();
+    append_records(ids, 3, count, 10, 10);
+    read_log(&view);
+    TEST_ASSERT_EQUAL_UINT32(0, view.out_of_order);
+    TEST_ASSERT_EQUAL_UINT32(count + 9, view.last.seq);
+    TEST_ASSERT_EQUAL_UINT32(count + 10 - view.first.seq, view.records);
+}
+
+TEST_CASE("Ergebnislog: beschädigter Eintrag beendet den Sektor, neuer Sektor danach", "[log]")
+{
+    const uint16_t ids[1] = { result_sink_register_test("log.torn") };
+    uint32_t end, used, used_after;
+    log_view_t view;
+    log_fresh();
+
+    append_records(ids, 1, 0, 20, 20);
+    result_log_close();
+
+    // Abgebrochener Schreibvorgang: Kopf steht, Nutzdaten und CRC passen nicht
+    uint32_t sector = newest_sector(&end, &used);
+    const esp_partition_t* part = log_partition();
+    const uint8_t torn[8] = { RESULT_FRAME_RECORD, sizeof(result_record_t), 0x34, 0x12, 0x00, 0x00, 0x55, 0x55 };
+    TEST_ASSERT_EQUAL(ESP_OK, esp_partition_write(part, sector * part->erase_size + end, torn, sizeof(torn)));
+
+    TEST_ASSERT_TRUE(result_log_init(BUILD));
+    TEST_ASSERT_EQUAL_UINT32(22, read_log(&view));
+    TEST_ASSERT_EQUAL_UINT32(20, view.records);
+
+    // Nicht hinter den beschädigten Eintrag schreiben, sondern neuer Sektor
+    append_records(ids, 1, 20, 5, 5);
+    newest_sector(&end, &used_after);
+    TEST_ASSERT_EQUAL_UINT32(used + 1, used_after);
+    read_log(&view);
+    TEST_ASSERT_EQUAL_UINT32(25, view.records);
+    TEST_ASSERT_EQUAL_UINT32(0, view.out_of_order);
+    TEST_ASSERT_EQUAL_UINT32(24, view.last.seq);
+    TEST_ASSERT_EQUAL_UINT32(2, view.boots);
+}
@@ -0,0 +1,54 @@
+// Result-Sink (result_sink.c): COBS-Framing
+//
+// Die hier ausgegebenen Frames prüft test/scripts/test_serial_logger.py im
+// Mitschnitt des Testlaufs mit dem Decoder von scripts/serial_logger.py.
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "result_sink.h"
+
+// Gleiche Werte in test/scripts/test_serial_logger.py
+#define LF_TEST_ID      0x0A0A
+#define LF_TEST_NAME    "lf\nframe"
+
+TEST_CASE("COBS: keine Nullbytes, Länge = Rohdaten + 1", "[result_sink]")
+{
+    static const uint8_t raw[] = { 0x00, 0x0A, 0x00, 0x00, 0x0D, 0x0A, 0xB5, 0x00 };
+    uint8_t encoded[sizeof(raw) + 2];
+
+    size_t n = cobs_encode(raw, sizeof(raw), encoded);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(raw) + 1, n);
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_NOT_EQUAL(0, encoded[i]);
+    }
+
+    // Block aus 254 Nicht-Nullbytes: zusätzliches Code-Byte 0xFF
+    uint8_t block[254];
+    uint8_t block_encoded[sizeof(block) + 2];
+    memset(block, 0x0A, sizeof(block));
+    n = cobs_encode(block, sizeof(block), block_encoded);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(block) + 2, n);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, block_encoded[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, block_encoded[n - 1]);
+}
+
+TEST_CASE("Frames: Name und Datensatz mit 0x0A-Bytes für den Decoder", "[result_sink]")
+{
+    uint8_t payload[2 + sizeof(LF_TEST_NAME) - 1];
+    const uint16_t id = LF_TEST_ID;
+    memcpy(payload, &id, 2);
+    memcpy(&payload[2], LF_TEST_NAME, sizeof(LF_TEST_NAME) - 1);
+    result_sink_emit_frame(RESULT_FRAME_TEST_NAME, payload, sizeof(payload));
+
+    // 0x0A in jedem Feld, dazu 0x0D 0x0A und Nullbytes
+    const result_record_t rec = {
+        .test_id = LF_TEST_ID,
+        .seq = 0x0A0A,
+        .iterations = 0x0A0A0A0A,
+        .cycles = 0x000A0D0A,
+        .checksum = 0x0A00000A,
+    };
+    result_sink_emit_frame(RESULT_FRAME_RECORD, &rec, sizeof(rec));
+    fflush(stdout);
+}
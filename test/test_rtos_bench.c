@@ -0,0 +1,87 @@
+// RTOS-Primitive (rtos_bench.c) auf dem FreeRTOS-POSIX-Port
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "bench_registry.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define RTOS_BENCH_PRIO     (configMAX_PRIORITIES - 10)     // wie rtos_bench.c
+#define ROUNDS              64
+
+static bench_def_t* find_bench(const char* name) {
+    for (bench_def_t* def = bench_first(); def != NULL; def = def->next) {
+        if (strcmp(def->name, name) == 0) {
+            return def;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Ruft einen RTOS-Fall direkt auf (ohne Runner)
+ * @return Ergebniswert des Falls
+ */
+static uint32_t run_case(const char* name, uint32_t rounds) {
+    bench_def_t* def = find_bench(name);
+    uint32_t result = UINT32_MAX;
+    UBaseType_t prio = uxTaskPriorityGet(NULL);
+
+    TEST_ASSERT_NOT_NULL_MESSAGE(def, name);
+    def->fn(def->arg, rounds, &result);
+    // Die Priorität des Aufrufers wird nach dem Sample zurückgesetzt
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(prio, uxTaskPriorityGet(NULL), name);
+    return result;
+}
+
+TEST_CASE("RTOS: alle Fälle mit .lat und .thr registriert", "[rtos]")
+{
+    static const char* const cases[] = {
+        "notify", "queue.4", "queue.32", "queue.128", "sem.binary", "sem.counting", "mutex.pi", "yield",
+    };
+    char name[32];
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        snprintf(name, sizeof(name), "%s.lat", cases[i]);
+        TEST_ASSERT_NOT_NULL_MESSAGE(find_bench(name), name);
+        snprintf(name, sizeof(name), "%s.thr", cases[i]);
+        TEST_ASSERT_NOT_NULL_MESSAGE(find_bench(name), name);
+    }
+    // ISR-Fall nur auf dem Target (GPTimer)
+    TEST_ASSERT_NULL(find_bench("isr.notify.lat"));
+}
+
+TEST_CASE("RTOS: Ping-Pong-Runden kommen vollständig zurück", "[rtos]")
+{
+    TEST_ASSERT_EQUAL_UINT32(ROUNDS, run_case("notify.thr", ROUNDS));
+    TEST_ASSERT_EQUAL_UINT32(1, run_case("notify.lat", 1));
+    TEST_ASSERT_EQUAL_UINT32(ROUNDS, run_case("sem.binary.thr", ROUNDS));
+    TEST_ASSERT_EQUAL_UINT32(ROUNDS, run_case("sem.counting.thr", ROUNDS));
+    TEST_ASSERT_EQUAL_UINT32(ROUNDS, run_case("yield.thr", ROUNDS));
+}
+
+TEST_CASE("RTOS: Queue liefert die zuletzt gesendete Nachricht zurück", "[rtos]")
+{
+    // Erstes Byte der Nachricht = Rundennummer
+    TEST_ASSERT_EQUAL_UINT32(ROUNDS - 1, run_case("queue.4.thr", ROUNDS));
+    TEST_ASSERT_EQUAL_UINT32(ROUNDS - 1, run_case("queue.32.thr", ROUNDS));
+    TEST_ASSERT_EQUAL_UINT32(ROUNDS - 1, run_case("queue.128.thr", ROUNDS));
+    TEST_ASSERT_EQUAL_UINT32(0, run_case("queue.4.lat", 1));
+}
+
+TEST_CASE("RTOS: Mutex-Halter erbt die Priorität des Messers", "[rtos]")
+{
+    TEST_ASSERT_EQUAL_UINT32(RTOS_BENCH_PRIO, run_case("mutex.pi.lat", 1));
+    TEST_ASSERT_EQUAL_UINT32(RTOS_BENCH_PRIO, run_case("mutex.pi.thr", ROUNDS));
+}
+
+TEST_CASE("RTOS: Suite läuft über den Runner", "[rtos]")
+{
+    bench_run_spec_t spec;
+    bench_run_spec_default(&spec);
+    spec.filter = "rtos";
+    spec.repeat = 1;
+    spec.iterations = 0;
+    spec.pmu_events = 0;
+    TEST_ASSERT_EQUAL_UINT32(16, bench_run(&spec));
+}
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Host-Tests der Benchmark-Komponente auf dem linux-Target.
+
+Baut das Testprojekt in ``test/`` für das linux-Target (FreeRTOS-POSIX-Port)
+und führt das ELF aus. Die Testfälle stehen in ``test/test_<modul>.c`` und
+laufen alle in einem Prozess; der Exit-Code ist die Anzahl der Fehlschläge.
+Danach prüft pytest die Skripte unter ``scripts/`` (``test/scripts/``), zum
+Teil anhand des Mitschnitts dieses Laufs (``build/bench_test.log``)::
+
+    source ~/esp/esp-idf/export.sh
+    python3 test/test_runner.py             # bauen und ausführen
+    python3 test/test_runner.py --no-build  # nur ausführen
+
+Es wird kein Board benötigt.
+"""
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+TEST_DIR = os.path.dirname(os.path.abspath(__file__))
+BUILD_DIR = os.path.join(TEST_DIR, 'build')
+ELF = os.path.join(BUILD_DIR, 'bench_test.elf')
+LOG = os.path.join(BUILD_DIR, 'bench_test.log')
+SCRIPT_TESTS = os.path.join(TEST_DIR, 'scripts')
+# CONFIG_BENCH_RESULT_LOG_HOST_IMAGE in sdkconfig.defaults
+FLASH_IMAGE = '/tmp/esp32c6-bench-test-flash.bin'
+
+# Unity-Zusammenfassung: "12 Tests 0 Failures 0 Ignored"
+SUMMARY_RE = re.compile(r'^(\d+) Tests (\d+) Failures (\d+) Ignored')
+
+
+def build():
+    """Setzt beim ersten Bau das linux-Target und baut das Testprojekt"""
+    if not os.environ.get('IDF_PATH'):
+        print('❌ IDF_PATH nicht gesetzt (source ~/esp/esp-idf/export.sh)', file=sys.stderr)
+        return False
+    steps = []
+    if not os.path.exists(os.path.join(TEST_DIR, 'sdkconfig')):
+        steps.append(['idf.py', '--preview', 'set-target', 'linux'])
+    steps.append(['idf.py', 'build'])
+    for cmd in steps:
+        if subprocess.run(cmd, cwd=TEST_DIR).returncode != 0:
+            print(f"❌ {' '.join(cmd)} fehlgeschlagen", file=sys.stderr)
+            return False
+    return True
+
+
+def run(timeout):
+    """Führt das Test-ELF aus, gibt die Ausgabe durch und wertet Unity aus"""
+    if not os.path.exists(ELF):
+        print(f'❌ {ELF} fehlt (ohne --no-build bauen)', file=sys.stderr)
+        return 1
+    # Emulierter Flash: jeder Lauf beginnt mit der Partitionstabelle dieses Builds
+    if os.path.exists(FLASH_IMAGE):
+        os.remove(FLASH_IMAGE)
+    try:
+        proc = subprocess.run([ELF], cwd=TEST_DIR, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                              timeout=timeout)
+    except subprocess.TimeoutExpired:
+        print(f'❌ Zeitlimit von {timeout} s überschritten', file=sys.stderr)
+        return 1
+
+    # Rohbytes mit Binärframes für test/scripts/
+    with open(LOG, 'wb') as f:
+        f.write(proc.stdout)
+    output = proc.stdout.decode('utf-8', errors='replace')
+    print(output, end='')
+    summary = None
+    for line in output.splitlines():
+        match = SUMMARY_RE.match(line.strip())
+        if match:
+            summary = tuple(int(v) for v in match.groups())
+
+    if summary is None:
+        print(f'❌ Keine Unity-Zusammenfassung (Exit-Code {proc.returncode})', file=sys.stderr)
+        return 1
+    tests, failures, ignored = summary
+    if failures or proc.returncode != 0:
+        print(f'❌ {failures} von {tests} Tests fehlgeschlagen', file=sys.stderr)
+        return 1
+    print(f'✅ {tests} Tests bestanden' + (f' ({ignored} ignoriert)' if ignored else ''))
+    return 0
+
+
+def run_scripts():
+    """Führt die pytest-Tests der Host-Skripte aus"""
+    try:
+        import pytest  # noqa: F401
+    except ImportError:
+        print('⚠️  pytest nicht installiert, Skript-Tests übersprungen (pip install pytest)', file=sys.stderr)
+        return 0
+    env = dict(os.environ, BENCH_TEST_LOG=LOG)
+    if subprocess.run([sys.executable, '-m', 'pytest', '-q', SCRIPT_TESTS], env=env).returncode != 0:
+        print('❌ Skript-Tests fehlgeschlagen', file=sys.stderr)
+        return 1
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Host-Tests der Benchmark-Komponente (linux-Target)')
+    parser.add_argument('--no-build', action='store_true', help='Nicht bauen, nur ausführen')
+    parser.add_argument('--timeout', type=int, default=300, help='Zeitlimit für den Testlauf in Sekunden')
+    args = parser.parse_args()
+
+    if not args.no_build and not build():
+        return 1
+    if run(args.timeout) != 0:
+        return 1
+    return run_scripts()
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,69 @@
+// Trace-Punkte (trace.c): Namenstabelle, Dump und Ringüberlauf
+//
+// Jeder Fall leert den Ring und gibt ihn am Ende aus; test/scripts/
+// test_trace_to_json.py liest die Dumps aus dem Mitschnitt des Testlaufs
+// mit scripts/trace_to_json.py und prüft die Ereignisse.
+
+#include <string.h>
+#include "unity.h"
+#include "trace.h"
+#include "result_sink.h"
+#include "bench_registry.h"
+
+// Gleiche Werte in test/scripts/test_trace_to_json.py
+#define WRAP_EXTRA      5
+
+/**
+ * @brief Leert den Ring, nachdem der Drain-Task fertig ist (keine fremden Ereignisse)
+ */
+static void trace_start_case(void) {
+    result_sink_flush();
+    trace_clear();
+}
+
+TEST_CASE("Trace: Namen per Inhalt, nicht per Zeiger", "[trace]")
+{
+    char name[] = "test.trace.intern";
+    uint16_t id = trace_intern("test.trace.intern");
+
+    TEST_ASSERT_NOT_EQUAL(TRACE_ID_NONE, id);
+    TEST_ASSERT_EQUAL_UINT32(id, trace_intern(name));
+    TEST_ASSERT_NOT_EQUAL(id, trace_intern("test.trace.intern2"));
+}
+
+TEST_CASE("Trace: Ereignisse statischer und dynamischer Stellen im Dump", "[trace]")
+{
+    trace_start_case();
+    TRACE_BEGIN("test.trace.span");
+    TRACE_INSTANT("test.trace.mark", 42);
+    TRACE_BEGIN_DYN("test.trace.dyn", 7);
+    TRACE_END_DYN("test.trace.dyn", 7);
+    TRACE_END("test.trace.span");
+    trace_dump();
+}
+
+TEST_CASE("Trace: Überlauf behält die neuesten Ereignisse", "[trace]")
+{
+    trace_start_case();
+    for (uint32_t i = 0; i < CONFIG_BENCH_TRACE_EVENTS + WRAP_EXTRA; i++) {
+        TRACE_INSTANT("test.trace.wrap", i);
+    }
+    trace_dump();
+}
+
+TEST_CASE("Trace: trace.emit und trace.emit_id schreiben in den Ring", "[trace]")
+{
+    static const char* const benches[] = { "trace.emit", "trace.emit_id" };
+
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+        bench_run_spec_t spec;
+        bench_run_spec_default(&spec);
+        spec.filter = benches[i];
+        spec.repeat = 1;
+        spec.pmu_events = 0;
+
+        trace_start_case();
+        TEST_ASSERT_EQUAL_UINT32(1, bench_run(&spec));
+        trace_dump();
+    }
+}